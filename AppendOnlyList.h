@@ -0,0 +1,56 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+
+// Grow-only list that readers can walk without locking while a writer appends.
+// Entries live in fixed-size chunks that never move; a reader loads size()
+// once and may then read every index below it. Appends are serialized by an
+// internal mutex that readers never touch.
+template <typename T>
+class AppendOnlyList {
+public:
+    static constexpr size_t kChunkSize = 4096;
+    static constexpr size_t kMaxChunks = 4096;
+
+    AppendOnlyList() = default;
+    AppendOnlyList(const AppendOnlyList&) = delete;
+    AppendOnlyList& operator=(const AppendOnlyList&) = delete;
+
+    ~AppendOnlyList() {
+        for (auto& chunk : chunks) {
+            delete[] chunk.load(std::memory_order_relaxed);
+        }
+    }
+
+    // Returns false once kChunkSize * kMaxChunks entries have been appended
+    bool append(T value) {
+        std::lock_guard<std::mutex> lock(appendMutex);
+        size_t n = count.load(std::memory_order_relaxed);
+        size_t chunkIndex = n / kChunkSize;
+        if (chunkIndex >= kMaxChunks) return false;
+
+        T* chunk = chunks[chunkIndex].load(std::memory_order_relaxed);
+        if (!chunk) {
+            chunk = new T[kChunkSize];
+            chunks[chunkIndex].store(chunk, std::memory_order_release);
+        }
+        chunk[n % kChunkSize] = std::move(value);
+        count.store(n + 1, std::memory_order_release);  // publishes the entry
+        return true;
+    }
+
+    size_t size() const { return count.load(std::memory_order_acquire); }
+
+    // Only valid for i below a value previously returned by size()
+    const T& operator[](size_t i) const {
+        return chunks[i / kChunkSize].load(std::memory_order_acquire)[i % kChunkSize];
+    }
+
+private:
+    std::array<std::atomic<T*>, kMaxChunks> chunks{};
+    std::atomic<size_t> count{ 0 };
+    std::mutex appendMutex;
+};
@@ -0,0 +1,144 @@
+#include "Bytecode.h"
+#include <algorithm>
+#include <cctype>
+
+namespace {
+
+class Compiler {
+public:
+    explicit Compiler(Program& program) : program(program) {}
+
+    void emitBlock(const std::vector<Instruction>& instructions, int depth) {
+        for (const auto& ins : instructions) {
+            emitInstruction(ins, depth);
+            if (depth == 0) {
+                program.code.back().flags |= kEndsLine;
+            }
+        }
+    }
+
+private:
+    Program& program;
+
+    uint16_t slotFor(const std::string& name) {
+        return program.symbols.resolve(name);
+    }
+
+    static bool isNumber(const std::string& arg) {
+        return !arg.empty() && std::all_of(arg.begin(), arg.end(),
+            [](unsigned char c) { return std::isdigit(c); });
+    }
+
+    // arg is all digits (see isNumber); saturates at UINT16_MAX
+    static uint16_t toImmediate(const std::string& arg) {
+        uint32_t value = 0;
+        for (unsigned char c : arg) {
+            value = std::min<uint32_t>(value * 10 + (c - '0'), UINT16_MAX);
+        }
+        return static_cast<uint16_t>(value);
+    }
+
+    // Numeric literals become immediates; anything else names a variable
+    uint16_t operand(const std::string& arg, uint8_t registerFlag, uint8_t& flags) {
+        if (isNumber(arg)) return toImmediate(arg);
+        flags |= registerFlag;
+        return slotFor(arg);
+    }
+
+    void emit(OpCode code, uint8_t flags = 0, uint16_t dst = 0, uint16_t lhs = 0, uint16_t rhs = 0) {
+        program.code.push_back(Op{ code, flags, dst, lhs, rhs, 0 });
+    }
+
+    void emitInstruction(const Instruction& ins, int depth) {
+        uint8_t flags = 0;
+
+        switch (ins.type) {
+        case InstructionType::PRINT:
+            emit(OpCode::PRINT);
+            break;
+        case InstructionType::DECLARE:
+            if (ins.args.size() >= 2) {
+                uint16_t value = operand(ins.args[1], kLhsIsRegister, flags);
+                emit(OpCode::DECLARE, flags, slotFor(ins.args[0]), value);
+            }
+            else {
+                emit(OpCode::PRINT);    // malformed: keep the line count intact
+            }
+            break;
+        case InstructionType::ADD:
+        case InstructionType::SUBTRACT:
+            if (ins.args.size() >= 3) {
+                uint16_t lhs = operand(ins.args[1], kLhsIsRegister, flags);
+                uint16_t rhs = operand(ins.args[2], kRhsIsRegister, flags);
+                OpCode code = ins.type == InstructionType::ADD ? OpCode::ADD : OpCode::SUBTRACT;
+                emit(code, flags, slotFor(ins.args[0]), lhs, rhs);
+            }
+            else {
+                emit(OpCode::PRINT);
+            }
+            break;
+        case InstructionType::SLEEP: {
+            uint16_t ticks = ins.args.empty() ? 0 : operand(ins.args[0], kLhsIsRegister, flags);
+            emit(OpCode::SLEEP, flags, 0, ticks);
+            break;
+        }
+        case InstructionType::FOR: {
+            uint32_t begin = static_cast<uint32_t>(program.code.size());
+            uint16_t repeats = static_cast<uint16_t>(std::clamp(ins.repeatCount, 0, static_cast<int>(UINT16_MAX)));
+            emit(OpCode::LOOP_BEGIN, 0, 0, repeats);
+            emitBlock(ins.body, depth + 1);
+            uint32_t end = static_cast<uint32_t>(program.code.size());
+            emit(OpCode::LOOP_END);
+            program.code[begin].jump = end;
+            program.code[end].jump = begin;
+            program.maxLoopDepth = std::max(program.maxLoopDepth, depth + 1);
+            break;
+        }
+        default:
+            emit(OpCode::PRINT);
+            break;
+        }
+    }
+};
+
+}
+
+// Ops emitted for a block: one per instruction, plus LOOP_BEGIN/LOOP_END around each FOR body
+static size_t countOps(const std::vector<Instruction>& instructions) {
+    size_t count = 0;
+    for (const auto& ins : instructions) {
+        count += ins.type == InstructionType::FOR ? 2 + countOps(ins.body) : 1;
+    }
+    return count;
+}
+
+Program Program::compile(const std::vector<Instruction>& instructions, size_t maxVariables) {
+    Program program;
+    program.symbols = SymbolTable(maxVariables);
+    program.code.reserve(countOps(instructions));  // exact, so code is allocated once
+    Compiler compiler(program);
+    compiler.emitBlock(instructions, 0);
+    program.symbols.seal();
+
+    // Variables that did not fit in the symbol table: reads become the
+    // immediate 0 and writes go to a sink slot past the real registers
+    uint16_t sink = static_cast<uint16_t>(program.symbols.size());
+    program.registerCount = sink;
+    for (auto& op : program.code) {
+        if ((op.flags & kLhsIsRegister) && op.lhs == SymbolTable::kNoSlot) {
+            op.flags &= ~kLhsIsRegister;
+            op.lhs = 0;
+        }
+        if ((op.flags & kRhsIsRegister) && op.rhs == SymbolTable::kNoSlot) {
+            op.flags &= ~kRhsIsRegister;
+            op.rhs = 0;
+        }
+        if (op.dst == SymbolTable::kNoSlot) {
+            op.dst = sink;
+            program.registerCount = sink + 1;
+        }
+    }
+
+    program.lineCount = static_cast<int>(instructions.size());
+    return program;
+}
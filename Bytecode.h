@@ -0,0 +1,40 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Instruction.h"
+#include "SymbolTable.h"
+
+// Flat, pre-decoded form of an Instruction tree. Variable names are resolved to
+// register slots and numeric arguments to immediates once, when the process is
+// created, so the interpreter never parses strings or hashes names.
+enum class OpCode : uint8_t {
+    PRINT, DECLARE, ADD, SUBTRACT, SLEEP,
+    LOOP_BEGIN,     // FOR: lhs = repeat count, jump = index of the matching LOOP_END
+    LOOP_END        // jump = index of the matching LOOP_BEGIN
+};
+
+// Op::flags bits
+constexpr uint8_t kLhsIsRegister = 0x01;
+constexpr uint8_t kRhsIsRegister = 0x02;
+constexpr uint8_t kEndsLine = 0x80;     // completing this op completes a top-level instruction
+
+struct Op {
+    OpCode code;
+    uint8_t flags;
+    uint16_t dst;       // destination register slot
+    uint16_t lhs;       // register slot or immediate, see flags
+    uint16_t rhs;       // register slot or immediate, see flags
+    uint32_t jump;      // loop ops only
+};
+
+struct Program {
+    std::vector<Op> code;
+    SymbolTable symbols;                // register slot -> variable name, for logs
+    uint16_t registerCount = 0;         // symbols.size(), plus a write-only sink slot if the table overflowed
+    int lineCount = 0;                  // number of top-level instructions
+    int maxLoopDepth = 0;
+
+    // maxVariables caps the symbol table (0 = unlimited)
+    static Program compile(const std::vector<Instruction>& instructions, size_t maxVariables = 0);
+};
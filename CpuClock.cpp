@@ -0,0 +1,27 @@
+#include "CpuClock.h"
+
+CpuClock::CpuClock(std::chrono::milliseconds idlePeriod)
+    : ticks(0), idleTicks(0), idlePeriod(idlePeriod) {
+}
+
+void CpuClock::idleTick() {
+    idleTicks.fetch_add(1, std::memory_order_relaxed);
+    advance();
+}
+
+uint64_t CpuClock::waitUntil(uint64_t target, const std::atomic<bool>& running) {
+    // Busy ticks are published without notification to keep advance() cheap,
+    // so waiters poll once per idle period instead of spinning on the counter.
+    std::unique_lock<std::mutex> lock(waitMutex);
+    uint64_t current = now();
+    while (current < target && running) {
+        waitCv.wait_for(lock, idlePeriod);
+        current = now();
+    }
+    return current;
+}
+
+void CpuClock::wakeAll() {
+    std::lock_guard<std::mutex> lock(waitMutex);
+    waitCv.notify_all();
+}
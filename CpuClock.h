@@ -0,0 +1,40 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+// Simulated global CPU clock shared by the dispatcher and all core workers.
+// Core workers advance it once per executed instruction; idle cores advance it
+// once per idle period so time keeps moving when there is no work.
+class CpuClock {
+public:
+    explicit CpuClock(std::chrono::milliseconds idlePeriod = std::chrono::milliseconds(1));
+
+    uint64_t now() const { return ticks.load(std::memory_order_relaxed); }
+
+    // Hot path: called by core workers for every executed instruction
+    void advance(uint64_t n = 1) { ticks.fetch_add(n, std::memory_order_relaxed); }
+
+    // Called by an idle core after waiting one idle period without work
+    void idleTick();
+    uint64_t getIdleTicks() const { return idleTicks.load(std::memory_order_relaxed); }
+
+    // Blocks until the clock reaches target or running becomes false.
+    // Returns the tick observed on wake-up.
+    uint64_t waitUntil(uint64_t target, const std::atomic<bool>& running);
+
+    // Wakes every thread blocked in waitUntil (used on scheduler stop)
+    void wakeAll();
+
+    std::chrono::milliseconds getIdlePeriod() const { return idlePeriod; }
+
+private:
+    std::atomic<uint64_t> ticks;
+    std::atomic<uint64_t> idleTicks;
+    std::chrono::milliseconds idlePeriod;
+
+    std::mutex waitMutex;
+    std::condition_variable waitCv;
+};
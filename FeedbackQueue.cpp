@@ -0,0 +1,42 @@
+#include "FeedbackQueue.h"
+#include <algorithm>
+
+FeedbackQueue::FeedbackQueue(int levelCount)
+    : levels(std::clamp(levelCount, 1, kMaxLevels)) {
+}
+
+void FeedbackQueue::push(std::shared_ptr<Process> proc) {
+    int level = std::clamp(proc->getPolicyState().level, 0, getLevelCount() - 1);
+    levels[level].push_back(std::move(proc));
+    nonEmpty |= uint32_t(1) << level;
+    ++count;
+}
+
+std::shared_ptr<Process> FeedbackQueue::pop() {
+    if (nonEmpty == 0) return nullptr;
+    int level = lowestSetBit(nonEmpty);
+    auto& queue = levels[level];
+    auto proc = std::move(queue.front());
+    queue.pop_front();
+    if (queue.empty()) nonEmpty &= ~(uint32_t(1) << level);
+    --count;
+    return proc;
+}
+
+size_t FeedbackQueue::boostAll(uint64_t epoch) {
+    for (auto& proc : levels[0]) {
+        proc->getPolicyState().epoch = epoch;
+    }
+    size_t moved = 0;
+    for (int level = 1; level < getLevelCount(); ++level) {
+        for (auto& proc : levels[level]) {
+            proc->getPolicyState().level = 0;
+            proc->getPolicyState().epoch = epoch;
+            levels[0].push_back(std::move(proc));
+            ++moved;
+        }
+        levels[level].clear();
+    }
+    if (count > 0) nonEmpty = 1;
+    return moved;
+}
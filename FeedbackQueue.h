@@ -0,0 +1,48 @@
+#pragma once
+#include "Process.h"
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Ready queue for the mlfq scheduler: one FIFO per priority level (0 = highest)
+// and a bitmap of the non-empty levels, so push and pop are O(1) however many
+// processes are queued. Each process carries its level in its PolicyState.
+// Not synchronized: MlfqPolicy holds its lock around every call.
+class FeedbackQueue {
+public:
+    static constexpr int kMaxLevels = 32;
+
+    explicit FeedbackQueue(int levelCount = 3);
+
+    void push(std::shared_ptr<Process> proc);
+    std::shared_ptr<Process> pop();
+
+    // Moves every queued process to level 0 (stamping epoch), behind the ones
+    // already there and in level order; returns how many moved
+    size_t boostAll(uint64_t epoch);
+
+    bool empty() const { return nonEmpty == 0; }
+    size_t size() const { return count; }
+    size_t sizeOf(int level) const { return levels[level].size(); }
+    int getLevelCount() const { return static_cast<int>(levels.size()); }
+
+private:
+    std::vector<std::deque<std::shared_ptr<Process>>> levels;
+    uint32_t nonEmpty = 0;      // bit l set = levels[l] has processes
+    size_t count = 0;
+
+    static int lowestSetBit(uint32_t bits) {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward(&index, bits);
+        return static_cast<int>(index);
+#else
+        return __builtin_ctz(bits);
+#endif
+    }
+};
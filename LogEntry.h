@@ -0,0 +1,22 @@
+#pragma once
+#include <cstdint>
+#include "Bytecode.h"
+
+enum class LogKind : uint8_t {
+    EXECUTED,           // an op ran; see opcode
+    LOOP_ITERATION,     // a FOR started iteration `result`
+    LOOP_ENDED          // a FOR finished its last iteration
+};
+
+// Fixed-size record of one logged event. Workers store these as-is; text is
+// only produced when a log is actually viewed or exported (Process::formatLog).
+struct LogEntry {
+    uint64_t tick;      // CPU clock when the op executed
+    uint32_t pc;        // op index in the program, used to recover variable names
+    int16_t core;
+    LogKind kind;
+    OpCode opcode;
+    uint16_t lhs;       // operand values as read
+    uint16_t rhs;
+    uint16_t result;    // value written, sleep ticks, repeat count or iteration number
+};
@@ -0,0 +1,67 @@
+#pragma once
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// Bounded, thread-safe log storage. The worker appends while the console reads;
+// once full, the oldest entries are overwritten. Readers keep a cursor (the
+// sequence number of the next entry they want) so each read only touches
+// entries appended since the previous one.
+template <typename T>
+class LogRing {
+public:
+    explicit LogRing(size_t capacity) : capacity(capacity == 0 ? 1 : capacity) {}
+
+    void push(T entry) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (slots.size() < capacity) {
+            // Allocated on the first push rather than at construction, then never resized
+            if (slots.empty()) slots.reserve(capacity);
+            slots.push_back(std::move(entry));
+        }
+        else {
+            slots[head % capacity] = std::move(entry);
+        }
+        ++head;
+    }
+
+    // Calls fn(const T&) for every retained entry at or after cursor, oldest
+    // first, without copying them, then moves cursor past the newest entry.
+    // Returns how many requested entries had already been overwritten.
+    template <typename Fn>
+    uint64_t visitSince(uint64_t& cursor, Fn&& fn) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        uint64_t oldest = head - slots.size();
+        uint64_t dropped = 0;
+        if (cursor < oldest) {
+            dropped = oldest - cursor;
+            cursor = oldest;
+        }
+        for (; cursor < head; ++cursor) {
+            fn(slots[cursor % capacity]);
+        }
+        return dropped;
+    }
+
+    // Copying variant of visitSince for callers that must not hold the lock
+    uint64_t readSince(uint64_t& cursor, std::vector<T>& out) const {
+        return visitSince(cursor, [&](const T& entry) { out.push_back(entry); });
+    }
+
+    uint64_t totalAppended() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return head;
+    }
+
+    // Same as totalAppended, without the lock; only for the thread that pushes
+    uint64_t pushedSoFar() const { return head; }
+
+    size_t getCapacity() const { return capacity; }
+
+private:
+    mutable std::mutex mutex;
+    std::vector<T> slots;
+    size_t capacity;
+    uint64_t head = 0;  // sequence number of the next entry to be pushed
+};
@@ -0,0 +1,219 @@
+#include "LogWriter.h"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+constexpr size_t kRunFileBuffer = size_t(1) << 20;
+}
+
+LogWriter::~LogWriter() {
+    close();
+}
+
+bool LogWriter::open(Mode newMode, const std::string& newPath, int numCores,
+    std::chrono::milliseconds newFlushInterval, std::chrono::milliseconds newSyncInterval) {
+    close();
+    path = newPath;
+    flushInterval = std::max(newFlushInterval, std::chrono::milliseconds(1));
+    syncInterval = newSyncInterval;
+    if (newMode == Mode::Off) return true;
+
+    if (newMode == Mode::Run) {
+        runFile = std::fopen(path.c_str(), "wb");
+        if (!runFile) return false;
+        std::setvbuf(runFile, nullptr, _IOFBF, kRunFileBuffer);
+    }
+    else {
+        std::error_code error;
+        std::filesystem::create_directories(path, error);
+        if (error) return false;
+    }
+
+    buffers.clear();
+    for (int c = 0; c < numCores; ++c) {
+        buffers.push_back(std::make_unique<Buffer>());
+    }
+    {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        counters = LogWriterStats();
+    }
+    stopping = false;
+    unsynced = false;
+    lastSync = std::chrono::steady_clock::now();
+    mode = newMode;
+    thread = std::thread(&LogWriter::run, this);
+    return true;
+}
+
+void LogWriter::close() {
+    if (thread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        thread.join();     // the last batch is written and synced on the way out
+    }
+    if (runFile) {
+        std::fclose(runFile);
+        runFile = nullptr;
+    }
+    startedFiles.clear();
+    mode = Mode::Off;
+}
+
+void LogWriter::flush() {
+    if (!thread.joinable()) return;
+    std::unique_lock<std::mutex> lock(mutex);
+    uint64_t ticket = ++flushRequests;
+    wake.notify_all();
+    flushed.wait(lock, [&] { return flushesDone >= ticket || stopping; });
+}
+
+LogWriterStats LogWriter::stats() const {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    return counters;
+}
+
+void LogWriter::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    bool last = false;
+    while (!last) {
+        wake.wait_for(lock, flushInterval, [&] { return stopping || flushRequests > flushesDone; });
+        last = stopping;
+        uint64_t requested = flushRequests;
+        bool sync = last || requested > flushesDone;
+        lock.unlock();
+        writeBatch(sync);
+        lock.lock();
+        flushesDone = requested;
+        flushed.notify_all();
+    }
+}
+
+// One wake-up: takes every core's buffer and writes what they collected.
+// Bursts of one process may sit in several cores' buffers, so they are put
+// back in log order first: per process for per-process files, by tick (then
+// process) for the run file. The run file is only in tick order within a
+// batch; a burst collected late can hold older ticks than the previous batch.
+void LogWriter::writeBatch(bool forceSync) {
+    auto now = std::chrono::steady_clock::now();
+    bool sync = forceSync || (syncInterval.count() > 0 && now - lastSync >= syncInterval);
+    LogWriterStats batch;
+
+    taken.resize(buffers.size());
+    order.clear();
+    for (size_t c = 0; c < buffers.size(); ++c) {
+        Batch& mine = taken[c];
+        mine.bursts.clear();    // keeps the capacity for the core
+        mine.entries.clear();
+        {
+            std::lock_guard<std::mutex> lock(buffers[c]->mutex);
+            std::swap(mine.bursts, buffers[c]->bursts);
+            std::swap(mine.entries, buffers[c]->entries);
+        }
+        const LogEntry* next = mine.entries.data();
+        for (const Burst& burst : mine.bursts) {
+            order.push_back(BurstRef{ &burst, next });
+            next += burst.count;
+        }
+    }
+
+    bool perProcess = mode == Mode::PerProcess;
+    std::sort(order.begin(), order.end(), [perProcess](const BurstRef& a, const BurstRef& b) {
+        const Burst& x = *a.burst;
+        const Burst& y = *b.burst;
+        if (!perProcess && x.tick != y.tick) return x.tick < y.tick;
+        if (x.proc != y.proc) return x.proc->getId() < y.proc->getId();
+        return x.sequence < y.sequence;
+    });
+
+    for (size_t i = 0; i < order.size(); ++i) {
+        const Burst& burst = *order[i].burst;
+        const Process& proc = *burst.proc;
+        std::string prefix = perProcess ? std::string() : proc.getName() + " ";
+        if (burst.dropped > 0) {
+            text += prefix + "... " + std::to_string(burst.dropped) + " log entries overwritten before they were written ...\n";
+        }
+        for (size_t e = 0; e < burst.count; ++e) {
+            text += prefix;
+            text += proc.formatLog(order[i].entries[e]);
+            text += '\n';
+        }
+        batch.lines += burst.count;
+        batch.lost += burst.dropped;
+
+        bool lastOfProcess = i + 1 == order.size() || order[i + 1].burst->proc != burst.proc;
+        if (perProcess && lastOfProcess) {
+            // The process's file is complete once its final burst is written
+            bool finished = burst.last;
+            if (writeProcessFile(proc, sync || finished)) {
+                batch.bytes += text.size();
+            }
+            else {
+                ++batch.writeErrors;
+            }
+            if (finished) startedFiles.erase(proc.getId());
+            text.clear();
+        }
+    }
+    order.clear();
+
+    if (mode == Mode::Run && runFile) {
+        if (!text.empty()) {
+            std::fwrite(text.data(), 1, text.size(), runFile);
+            batch.bytes += text.size();
+            unsynced = true;
+            text.clear();
+        }
+        if (sync && unsynced) {
+            std::fflush(runFile);
+            syncFile(runFile);
+            unsynced = false;
+            ++batch.syncs;
+        }
+    }
+    if (sync) lastSync = now;
+
+    std::lock_guard<std::mutex> lock(statsMutex);
+    counters.lines += batch.lines;
+    counters.bytes += batch.bytes;
+    counters.syncs += batch.syncs;
+    counters.lost += batch.lost;
+    counters.writeErrors += batch.writeErrors;
+    if (batch.lines > 0 || batch.lost > 0) ++counters.batches;
+}
+
+// Appends text to path/<name>.txt, truncating it on the process's first burst
+bool LogWriter::writeProcessFile(const Process& proc, bool sync) {
+    std::string name = proc.getName();
+    for (char& c : name) {
+        if (!std::isalnum(static_cast<unsigned char>(c)) && c != '-' && c != '_' && c != '.') c = '_';
+    }
+    std::string filePath = path + "/" + name + ".txt";
+    bool started = !startedFiles.insert(proc.getId()).second;
+    std::FILE* file = std::fopen(filePath.c_str(), started ? "ab" : "wb");
+    if (!file) return false;
+    std::fwrite(text.data(), 1, text.size(), file);
+    if (sync) {
+        std::fflush(file);
+        syncFile(file);
+    }
+    std::fclose(file);
+    return true;
+}
+
+void LogWriter::syncFile(std::FILE* file) {
+#if defined(_WIN32)
+    _commit(_fileno(file));
+#else
+    fsync(fileno(file));
+#endif
+}
@@ -0,0 +1,136 @@
+#pragma once
+#include "LogEntry.h"
+#include "Process.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+// Counters for report-util
+struct LogWriterStats {
+    uint64_t lines = 0;         // log lines written
+    uint64_t bytes = 0;
+    uint64_t batches = 0;       // wake-ups that wrote something
+    uint64_t syncs = 0;
+    uint64_t lost = 0;          // entries overwritten in a process's log ring before a core handed them over
+    uint64_t writeErrors = 0;   // per-process files that could not be opened
+};
+
+// Persists process logs on a background thread (config key log-persist).
+// The core running a process copies the fixed-size entries it logged into
+// that core's buffer at the end of every burst, and also mid-burst whenever
+// half the process's log ring is pending (see LogDrain), which costs a short
+// memcpy and no I/O. Every flushInterval the writer swaps the buffers out,
+// formats the entries and writes them with one large write per file. Batches
+// are fsynced at most every syncInterval and always by flush() and close(); a
+// per-process file is also fsynced once its process has finished.
+//
+// Modes: "run" appends every process's lines, prefixed with its name, to the
+// file at path, ordered by tick within each batch only; "process" writes
+// path/<name>.txt per process, always in log order.
+class LogWriter : public LogDrain {
+public:
+    enum class Mode { Off, Run, PerProcess };
+
+    ~LogWriter();
+
+    // Writes out and stops any previous writer, then starts a new one unless
+    // mode is Off. Returns false if the log file or directory cannot be created.
+    bool open(Mode mode, const std::string& path, int numCores,
+        std::chrono::milliseconds flushInterval, std::chrono::milliseconds syncInterval);
+    void close();
+
+    bool isOpen() const { return mode != Mode::Off; }
+    const std::string& getPath() const { return path; }
+
+    // Called by the core that just ran proc, after its burst (and after
+    // markFinished if it was the last one)
+    void collect(int coreId, const std::shared_ptr<Process>& proc) {
+        if (mode == Mode::Off) return;
+        Buffer& buffer = *buffers[coreId];
+        std::lock_guard<std::mutex> lock(buffer.mutex);
+        size_t first = buffer.entries.size();
+        uint64_t sequence = proc->getPersistedLogs();
+        uint64_t dropped = proc->takeNewLogs(buffer.entries);
+        size_t count = buffer.entries.size() - first;
+        if (count > 0 || dropped > 0) {
+            uint64_t tick = count > 0 ? buffer.entries[first].tick : 0;
+            bool last = proc->getState() == ProcessState::FINISHED;
+            buffer.bursts.push_back(Burst{ proc, sequence, tick, dropped, count, last });
+        }
+    }
+
+    // Mid-burst collect, from inside Process::run and Process::step
+    void drain(int coreId, Process& proc) override { collect(coreId, proc.shared_from_this()); }
+
+    // Writes everything collected so far and fsyncs before returning
+    void flush();
+
+    LogWriterStats stats() const;
+
+private:
+    // Entries one process logged between two collects, in order, within
+    // Batch::entries; a long burst is split into several
+    struct Burst {
+        std::shared_ptr<Process> proc;
+        uint64_t sequence;      // log sequence number the burst starts at
+        uint64_t tick;          // tick of its first entry
+        uint64_t dropped;
+        size_t count;
+        bool last;              // the process finished in this burst
+    };
+
+    struct Batch {
+        std::vector<Burst> bursts;
+        std::vector<LogEntry> entries;
+    };
+
+    // One per core, so cores never contend with each other; the writer only
+    // holds the lock to swap the vectors
+    struct alignas(64) Buffer : Batch {
+        std::mutex mutex;
+    };
+
+    // A burst in a taken batch, with its entries
+    struct BurstRef {
+        const Burst* burst;
+        const LogEntry* entries;
+    };
+
+    Mode mode = Mode::Off;
+    std::string path;
+    std::chrono::milliseconds flushInterval{ 100 };
+    std::chrono::milliseconds syncInterval{ 1000 };
+    std::vector<std::unique_ptr<Buffer>> buffers;
+
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable flushed;
+    bool stopping = false;
+    uint64_t flushRequests = 0;     // flush() calls so far
+    uint64_t flushesDone = 0;       // flush() calls covered by a completed batch
+
+    // Only touched by the writer thread (and open/close while it is not running)
+    std::FILE* runFile = nullptr;
+    bool unsynced = false;                  // run file written since the last fsync
+    std::unordered_set<int> startedFiles;   // PIDs whose per-process file was truncated for this run
+    std::vector<Batch> taken;               // swapped with the cores' buffers, reused across batches
+    std::vector<BurstRef> order;
+    std::string text;
+    std::chrono::steady_clock::time_point lastSync;
+
+    mutable std::mutex statsMutex;
+    LogWriterStats counters;
+
+    void run();
+    void writeBatch(bool sync);
+    bool writeProcessFile(const Process& proc, bool sync);
+    static void syncFile(std::FILE* file);
+};
@@ -0,0 +1,194 @@
+#include "MemoryManager.h"
+#include <algorithm>
+
+MemoryManager::MemoryManager(size_t totalBytes, size_t frameBytes, Replacement replacement, const std::string& backingPath)
+    : pageShift(0), replacement(replacement) {
+    // Variables are 2-byte words; frames hold a power-of-two number of them
+    size_t words = std::max<size_t>(frameBytes / 2, 1);
+    while ((size_t(2) << pageShift) <= words) ++pageShift;
+
+    size_t frameCount = totalBytes / (getWordsPerFrame() * 2);
+    physical.assign(frameCount << pageShift, 0);
+    frames.resize(frameCount);
+    freeFrames.reserve(frameCount);
+    for (size_t f = frameCount; f-- > 0;) {
+        freeFrames.push_back(static_cast<int32_t>(f));
+    }
+
+    if (!backingPath.empty()) {
+        backing.open(backingPath, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+    }
+}
+
+MemoryStats MemoryManager::stats() const {
+    MemoryStats s;
+    s.frameBytes = getWordsPerFrame() * 2;
+    s.pageFaults = pageFaults.load(std::memory_order_relaxed);
+    s.pageIns = pageIns.load(std::memory_order_relaxed);
+    s.pageOuts = pageOuts.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(mutex);
+    s.totalFrames = frames.size();
+    s.usedFrames = frames.size() - freeFrames.size();
+    return s;
+}
+
+// Puts `page` of table into a frame, evicting another page if none is free.
+// Pages listed in keep are needed by the same instruction and are not evicted.
+bool MemoryManager::load(PageTable& table, uint32_t page, const uint32_t* keep, size_t keepCount) {
+    int32_t frame = -1;
+    if (!freeFrames.empty()) {
+        frame = freeFrames.back();
+        freeFrames.pop_back();
+    }
+    else {
+        frame = takeVictim(table, keep, keepCount);
+        if (frame < 0) return false;
+    }
+
+    uint16_t* words = frameWords(frame);
+    if (table.slots[page] >= 0 && backing.is_open()) {
+        readSlot(table.slots[page], words);
+        pageIns.fetch_add(1, std::memory_order_relaxed);
+    }
+    else {
+        std::fill(words, words + getWordsPerFrame(), uint16_t(0));
+    }
+
+    frames[frame].owner = &table;
+    frames[frame].page = page;
+    append(frame);
+    table.frames[page] = frame;
+    pageFaults.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+// Frees the first frame in replacement order that is not in use by another
+// running process, saving its page to the backing store if needed
+int32_t MemoryManager::takeVictim(const PageTable& faulting, const uint32_t* keep, size_t keepCount) {
+    int32_t frame = head;
+    for (; frame >= 0; frame = frames[frame].next) {
+        const Frame& f = frames[frame];
+        if (f.owner != &faulting) {
+            if (!f.owner->pinned) break;
+        }
+        else if (std::find(keep, keep + keepCount, f.page) == keep + keepCount) {
+            break;
+        }
+    }
+    if (frame < 0) return -1;
+
+    PageTable& victim = *frames[frame].owner;
+    uint32_t page = frames[frame].page;
+    // A clean page whose backing copy is still current needs no write
+    if (backing.is_open() && ((victim.flags[page] & PageTable::kDirty) || victim.slots[page] < 0)) {
+        if (victim.slots[page] < 0) {
+            if (!freeSlots.empty()) {
+                victim.slots[page] = freeSlots.back();
+                freeSlots.pop_back();
+            }
+            else {
+                victim.slots[page] = nextSlot++;
+            }
+        }
+        writeSlot(victim.slots[page], frameWords(frame));
+        pageOuts.fetch_add(1, std::memory_order_relaxed);
+    }
+    victim.flags[page] &= ~PageTable::kDirty;
+    victim.frames[page] = -1;
+    unlink(frame);
+    return frame;
+}
+
+void MemoryManager::unlink(int32_t frame) {
+    Frame& f = frames[frame];
+    if (f.prev >= 0) frames[f.prev].next = f.next;
+    else head = f.next;
+    if (f.next >= 0) frames[f.next].prev = f.prev;
+    else tail = f.prev;
+    f.prev = f.next = -1;
+}
+
+void MemoryManager::append(int32_t frame) {
+    Frame& f = frames[frame];
+    f.prev = tail;
+    f.next = -1;
+    if (tail >= 0) frames[tail].next = frame;
+    else head = frame;
+    tail = frame;
+}
+
+void MemoryManager::writeSlot(int32_t slot, const uint16_t* words) {
+    std::streamsize bytes = static_cast<std::streamsize>(getWordsPerFrame() * sizeof(uint16_t));
+    backing.seekp(static_cast<std::streamoff>(slot) * bytes);
+    backing.write(reinterpret_cast<const char*>(words), bytes);
+}
+
+void MemoryManager::readSlot(int32_t slot, uint16_t* words) {
+    std::streamsize bytes = static_cast<std::streamsize>(getWordsPerFrame() * sizeof(uint16_t));
+    backing.seekg(static_cast<std::streamoff>(slot) * bytes);
+    backing.read(reinterpret_cast<char*>(words), bytes);
+    if (backing.gcount() != bytes) {
+        // Short read (store not writable): the page comes back zeroed rather than torn
+        backing.clear();
+        std::fill(words, words + getWordsPerFrame(), uint16_t(0));
+    }
+}
+
+PageTable::PageTable(std::shared_ptr<MemoryManager> memory, size_t words)
+    : memory(std::move(memory)) {
+    pageShift = this->memory->getPageShift();
+    offsetMask = (uint32_t(1) << pageShift) - 1;
+    size_t pages = (words + offsetMask) >> pageShift;
+    frames.assign(pages, -1);
+    slots.assign(pages, -1);
+    flags.assign(pages, 0);
+}
+
+PageTable::~PageTable() {
+    std::lock_guard<std::mutex> lock(memory->mutex);
+    for (size_t page = 0; page < frames.size(); ++page) {
+        if (frames[page] >= 0) {
+            memory->unlink(frames[page]);
+            memory->frames[frames[page]].owner = nullptr;
+            memory->freeFrames.push_back(frames[page]);
+        }
+        if (slots[page] >= 0) {
+            memory->freeSlots.push_back(slots[page]);
+        }
+    }
+}
+
+void PageTable::pin() {
+    std::lock_guard<std::mutex> lock(memory->mutex);
+    pinned = true;
+}
+
+void PageTable::unpin() {
+    std::lock_guard<std::mutex> lock(memory->mutex);
+    pinned = false;
+    // LRU at burst granularity: pages used in this burst become the most recent
+    bool lru = memory->replacement == MemoryManager::Replacement::LRU;
+    for (size_t page = 0; page < frames.size(); ++page) {
+        if (lru && (flags[page] & kReferenced) && frames[page] >= 0) {
+            memory->unlink(frames[page]);
+            memory->append(frames[page]);
+        }
+        flags[page] &= ~kReferenced;
+    }
+}
+
+bool PageTable::fault(const uint16_t* wanted, size_t count) {
+    uint32_t pages[4];
+    count = std::min<size_t>(count, 4);
+    for (size_t i = 0; i < count; ++i) {
+        pages[i] = wanted[i] >> pageShift;
+    }
+
+    std::lock_guard<std::mutex> lock(memory->mutex);
+    for (size_t i = 0; i < count; ++i) {
+        if (frames[pages[i]] >= 0) continue;
+        faults.fetch_add(1, std::memory_order_relaxed);
+        if (!memory->load(*this, pages[i], pages, count)) return false;
+    }
+    return true;
+}
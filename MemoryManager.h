@@ -0,0 +1,137 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class PageTable;
+
+// What vmstat and report-util show about paged memory
+struct MemoryStats {
+    size_t frameBytes = 0;
+    size_t totalFrames = 0;
+    size_t usedFrames = 0;
+    uint64_t pageFaults = 0;    // accesses to a page without a frame
+    uint64_t pageIns = 0;       // faults served from the backing store (first touches are zero-filled)
+    uint64_t pageOuts = 0;      // evicted pages written to the backing store
+};
+
+// Physical memory for process variables, split into fixed-size frames that
+// processes' pages are demand-loaded into (config keys max-overall-mem,
+// mem-per-frame, page-replacement and backing-store). Evicted pages go to a
+// backing store file. Frames in use sit on one intrusive list in replacement
+// order (load order for fifo, last burst that used them for lru), so picking
+// a victim and updating recency are O(1).
+//
+// A running process's pages can only be evicted by that process itself: the
+// scheduler pins a page table for the length of a burst, which is what lets
+// the hit path read and write frames without taking the lock.
+class MemoryManager {
+public:
+    enum class Replacement { FIFO, LRU };
+
+    // frameBytes is rounded down to a power of two (at least one 2-byte word)
+    MemoryManager(size_t totalBytes, size_t frameBytes, Replacement replacement, const std::string& backingPath);
+
+    bool hasBackingStore() const { return backing.is_open(); }
+    size_t getWordsPerFrame() const { return size_t(1) << pageShift; }
+    uint32_t getPageShift() const { return pageShift; }
+    Replacement getReplacement() const { return replacement; }
+    MemoryStats stats() const;
+
+    uint16_t* frameWords(int32_t frame) { return &physical[static_cast<size_t>(frame) << pageShift]; }
+
+private:
+    friend class PageTable;
+
+    struct Frame {
+        PageTable* owner = nullptr;
+        uint32_t page = 0;
+        int32_t prev = -1;      // replacement list, head = next victim
+        int32_t next = -1;
+    };
+
+    uint32_t pageShift;
+    Replacement replacement;
+    std::vector<uint16_t> physical;
+    std::vector<Frame> frames;
+    std::vector<int32_t> freeFrames;
+    int32_t head = -1;
+    int32_t tail = -1;
+
+    std::fstream backing;
+    std::vector<int32_t> freeSlots;     // released backing store slots
+    int32_t nextSlot = 0;
+
+    mutable std::mutex mutex;
+    std::atomic<uint64_t> pageFaults{ 0 };
+    std::atomic<uint64_t> pageIns{ 0 };
+    std::atomic<uint64_t> pageOuts{ 0 };
+
+    // All below require mutex
+    bool load(PageTable& table, uint32_t page, const uint32_t* keep, size_t keepCount);
+    int32_t takeVictim(const PageTable& faulting, const uint32_t* keep, size_t keepCount);
+    void unlink(int32_t frame);
+    void append(int32_t frame);
+    void writeSlot(int32_t slot, const uint16_t* words);
+    void readSlot(int32_t slot, uint16_t* words);
+};
+
+// One process's variable space: register slot s lives at word s of the
+// process's virtual memory, on page s >> pageShift. Only the core running the
+// process uses the hit path, between pin() and unpin().
+class PageTable {
+public:
+    PageTable(std::shared_ptr<MemoryManager> memory, size_t words);
+    ~PageTable();   // returns its frames and backing store slots
+
+    PageTable(const PageTable&) = delete;
+    PageTable& operator=(const PageTable&) = delete;
+
+    // Brackets a burst: while pinned, no other process can take these frames
+    void pin();
+    void unpin();
+
+    // Makes the pages holding slots resident and marks them used (written for
+    // the first `written` slots). Returns false if every frame belongs to
+    // another running process; the caller gives up the core and retries later.
+    bool prepare(const uint16_t* slots, size_t count, size_t written) {
+        bool resident = true;
+        for (size_t i = 0; i < count; ++i) {
+            resident &= frames[slots[i] >> pageShift] >= 0;
+        }
+        if (!resident && !fault(slots, count)) return false;
+        // Only once every page is resident, so a page that failed to load is not marked dirty
+        for (size_t i = 0; i < count; ++i) {
+            flags[slots[i] >> pageShift] |= i < written ? (kReferenced | kDirty) : kReferenced;
+        }
+        return true;
+    }
+
+    // Hit path; the slot's page must have been prepared in this burst
+    uint16_t& word(uint16_t slot) {
+        return memory->frameWords(frames[slot >> pageShift])[slot & offsetMask];
+    }
+
+    uint64_t getPageFaults() const { return faults.load(std::memory_order_relaxed); }
+
+private:
+    friend class MemoryManager;
+
+    static constexpr uint8_t kReferenced = 0x01;   // used since the last unpin (lru)
+    static constexpr uint8_t kDirty = 0x02;        // written since it was loaded
+
+    std::shared_ptr<MemoryManager> memory;
+    uint32_t pageShift;
+    uint32_t offsetMask;
+    std::vector<int32_t> frames;    // per page, -1 = not resident
+    std::vector<int32_t> slots;     // per page backing store slot, -1 = never paged out
+    std::vector<uint8_t> flags;
+    bool pinned = false;            // guarded by the manager's mutex
+    std::atomic<uint64_t> faults{ 0 };
+
+    bool fault(const uint16_t* slots, size_t count);
+};
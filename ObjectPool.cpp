@@ -0,0 +1,42 @@
+#include "ObjectPool.h"
+#include <algorithm>
+
+FixedBlockPool::FixedBlockPool(size_t blockSize, size_t blockAlign, size_t blocksPerChunk)
+    : blockAlign(std::max(blockAlign, alignof(FreeBlock))), blocksPerChunk(blocksPerChunk == 0 ? 1 : blocksPerChunk) {
+    // Every block must hold a free-list link and keep the next block aligned
+    size_t size = std::max(blockSize, sizeof(FreeBlock));
+    this->blockSize = (size + this->blockAlign - 1) / this->blockAlign * this->blockAlign;
+}
+
+FixedBlockPool::~FixedBlockPool() {
+    for (void* chunk : chunks) {
+        ::operator delete(chunk, std::align_val_t(blockAlign));
+    }
+}
+
+void* FixedBlockPool::allocate() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!freeList) addChunk();
+    FreeBlock* block = freeList;
+    freeList = block->next;
+    return block;
+}
+
+void FixedBlockPool::deallocate(void* block) {
+    if (!block) return;
+    std::lock_guard<std::mutex> lock(mutex);
+    FreeBlock* freed = static_cast<FreeBlock*>(block);
+    freed->next = freeList;
+    freeList = freed;
+}
+
+// Caller holds mutex
+void FixedBlockPool::addChunk() {
+    char* chunk = static_cast<char*>(::operator new(blockSize * blocksPerChunk, std::align_val_t(blockAlign)));
+    chunks.push_back(chunk);
+    for (size_t i = blocksPerChunk; i-- > 0;) {
+        FreeBlock* block = reinterpret_cast<FreeBlock*>(chunk + i * blockSize);
+        block->next = freeList;
+        freeList = block;
+    }
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <vector>
+
+// Thread-safe pool of fixed-size memory blocks. Blocks are carved from large
+// chunks and recycled through a free list when released, so objects created
+// and destroyed at a high rate (process control blocks) stop going through
+// the general-purpose heap. Chunks are only freed with the pool itself.
+class FixedBlockPool {
+public:
+    FixedBlockPool(size_t blockSize, size_t blockAlign, size_t blocksPerChunk = 64);
+    ~FixedBlockPool();
+    FixedBlockPool(const FixedBlockPool&) = delete;
+    FixedBlockPool& operator=(const FixedBlockPool&) = delete;
+
+    void* allocate();
+    void deallocate(void* block);
+
+    size_t getBlockSize() const { return blockSize; }
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    size_t blockSize;
+    size_t blockAlign;
+    size_t blocksPerChunk;
+
+    std::mutex mutex;
+    FreeBlock* freeList = nullptr;
+    std::vector<void*> chunks;
+
+    void addChunk();
+};
+
+// Process-wide pool for blocks of Size bytes. Never destroyed, because pooled
+// objects may still be released during static destruction.
+template <size_t Size, size_t Align>
+FixedBlockPool& blockPool() {
+    static FixedBlockPool* pool = new FixedBlockPool(Size, Align);
+    return *pool;
+}
+
+// Standard allocator over blockPool, for std::allocate_shared. Single objects
+// come from the pool for their size; arrays fall back to operator new.
+template <typename T>
+class PoolAllocator {
+public:
+    using value_type = T;
+
+    PoolAllocator() = default;
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>&) noexcept {}
+
+    T* allocate(size_t n) {
+        if (n == 1) return static_cast<T*>(blockPool<sizeof(T), alignof(T)>().allocate());
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        if (n == 1) {
+            blockPool<sizeof(T), alignof(T)>().deallocate(p);
+        }
+        else {
+            ::operator delete(p);
+        }
+    }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U>&) const noexcept { return true; }
+    template <typename U>
+    bool operator!=(const PoolAllocator<U>&) const noexcept { return false; }
+};
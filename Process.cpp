@@ -1,16 +1,34 @@
 #include "Process.h"
+#include "ObjectPool.h"
 #include <chrono>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
-#include <thread>
 #include <atomic>
 #include <algorithm>
 
-Process::Process(int id, const std::string& name, const std::vector<Instruction>& instructions)
-    : id(id), name(name), instructions(instructions), currentLine(0), assignedCore(-1)
+Process::Process(int id, const std::string& name, const std::vector<Instruction>& instructions,
+    size_t maxVariables, size_t logCapacity)
+    : Process(id, name, std::make_shared<const Program>(Program::compile(instructions, maxVariables)), logCapacity)
+{
+}
+
+Process::Process(int id, const std::string& name, std::shared_ptr<const Program> program, size_t logCapacity)
+    : logs(logCapacity), name(name), id(id), program(std::move(program)), pc(0), currentLine(0), assignedCore(-1)
 {
     creationTimestamp = generateTimestamp();
+    registers.assign(this->program->registerCount, 0);
+    loopRemaining.reserve(this->program->maxLoopDepth);
+}
+
+std::shared_ptr<Process> Process::create(int id, const std::string& name, const std::vector<Instruction>& instructions,
+    size_t maxVariables, size_t logCapacity) {
+    return std::allocate_shared<Process>(PoolAllocator<Process>(), id, name, instructions, maxVariables, logCapacity);
+}
+
+std::shared_ptr<Process> Process::create(int id, const std::string& name, std::shared_ptr<const Program> program,
+    size_t logCapacity) {
+    return std::allocate_shared<Process>(PoolAllocator<Process>(), id, name, std::move(program), logCapacity);
 }
 
 // Generate timestamp at creation
@@ -34,16 +52,33 @@ std::string Process::getTimestamp() const {
 }
 
 // Runs the process; ends when stops running so scheduler.stop() doesn't need to wait for it
-void Process::run(int coreId, int delayPerExecution, int quantum, std::atomic<bool>& running) {
-    assignedCore = coreId;
+RunResult Process::run(int coreId, int delayPerExecution, int quantum, std::atomic<bool>& running, CpuClock& clock,
+    const std::atomic<bool>* preempt, LogDrain* drain) {
+    assignedCore.store(coreId, std::memory_order_relaxed);
     int cycles = 0;
+    const Op* code = program->code.data();
+    const size_t codeSize = program->code.size();
+    RunResult result = RunResult::FINISHED;
+
+    while (pc < codeSize) {
+        if (!running) {
+            result = RunResult::STOPPED;
+            break;
+        }
+        drainLogs(coreId, drain);
+
+        // Paged memory that cannot be made resident (every frame held by another
+        // running process): give the core up and retry the op on the next dispatch
+        if (pages && !pageIn(code[pc])) {
+            result = RunResult::PREEMPTED;
+            break;
+        }
 
-    while (currentLine < instructions.size()) {
-        if (!running) break;
+        // Loop bookkeeping (LOOP_END) is free; every other op costs one cycle
+        if (!executeOp(code[pc], clock.now())) continue;
 
-        executeInstruction(instructions[currentLine]);
-        ++currentLine;
         ++cycles;
+        clock.advance(); // one simulated CPU tick per executed instruction
 
         if (delayPerExecution > 0) {
             for (uint32_t d = 0; d < delayPerExecution; ++d) {
@@ -51,76 +86,232 @@ void Process::run(int coreId, int delayPerExecution, int quantum, std::atomic<bo
             }
         }
 
-        if (quantum > 0 && cycles >= quantum) break;
+        // SLEEP gives the core back; the scheduler parks the process until wakeTick
+        if (sleepRequested) {
+            sleepRequested = false;
+            result = RunResult::SLEEPING;
+            break;
+        }
+
+        bool preempted = (quantum > 0 && cycles >= quantum)
+            || (preempt && preempt->load(std::memory_order_relaxed));
+        if (preempted) {
+            result = pc < codeSize ? RunResult::PREEMPTED : RunResult::FINISHED;
+            break;
+        }
     }
+
+    // Published once per burst rather than per instruction; only this core writes it
+    cpuTicks.store(cpuTicks.load(std::memory_order_relaxed) + cycles, std::memory_order_relaxed);
+    return result;
 }
 
-// Executes a single instruction and logs the action
-void Process::executeInstruction(const Instruction& ins) {
-    std::ostringstream entry;
-    entry << "[" << getTimestamp() << "] ";
+RunResult Process::step(int coreId, uint64_t tick, LogDrain* drain) {
+    assignedCore.store(coreId, std::memory_order_relaxed);
+    const Op* code = program->code.data();
+    const size_t codeSize = program->code.size();
 
-    switch (ins.type) {
-    case InstructionType::PRINT:
-        entry << "PRINT: Hello world from " << name << "!";
-        break;
-    case InstructionType::DECLARE:
-        if (ins.args.size() >= 2) {
-            memory[ins.args[0]] = static_cast<uint16_t>(std::stoi(ins.args[1]));
-            entry << "DECLARE: " << ins.args[0] << " = " << ins.args[1];
+    while (pc < codeSize) {
+        drainLogs(coreId, drain);
+        if (pages && !pageIn(code[pc])) return RunResult::PREEMPTED;
+        if (!executeOp(code[pc], tick)) continue;
+        cpuTicks.store(cpuTicks.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+        if (sleepRequested) {
+            sleepRequested = false;
+            return RunResult::SLEEPING;
         }
-        break;
-    case InstructionType::ADD:
-        if (ins.args.size() >= 3) {
-            int sum = getValue(ins.args[1]) + getValue(ins.args[2]);
-            sum = std::clamp(sum, 0, static_cast<int>(UINT16_MAX));
-            memory[ins.args[0]] = static_cast<uint16_t>(sum);
-            entry << "ADD: " << ins.args[0] << " = " << ins.args[1] << " + " << ins.args[2]
-                << " -> " << sum;
+
+        // Loop ends are free, so close them now rather than spend the next tick on
+        // them. An empty FOR body repeats its LOOP_END here, logging every pass.
+        while (pc < codeSize && code[pc].code == OpCode::LOOP_END) {
+            drainLogs(coreId, drain);
+            executeOp(code[pc], tick);
         }
+        return pc < codeSize ? RunResult::PREEMPTED : RunResult::FINISHED;
+    }
+    return RunResult::FINISHED;
+}
+
+void Process::attachMemory(std::shared_ptr<MemoryManager> memory) {
+    pages = std::make_unique<PageTable>(std::move(memory), registers.size());
+    registers.clear();
+    registers.shrink_to_fit();
+}
+
+// Demand-pages the variables op touches. Returns false if they cannot all be made resident.
+bool Process::pageIn(const Op& op) {
+    uint16_t slots[3];
+    size_t count = 0;
+    size_t written = 0;
+    switch (op.code) {
+    case OpCode::DECLARE:
+    case OpCode::ADD:
+    case OpCode::SUBTRACT:
+        slots[count++] = op.dst;
+        written = 1;
         break;
-    case InstructionType::SUBTRACT:
-        if (ins.args.size() >= 3) {
-            int diff = getValue(ins.args[1]) - getValue(ins.args[2]);
-            diff = std::clamp(diff, 0, static_cast<int>(UINT16_MAX));
-            memory[ins.args[0]] = static_cast<uint16_t>(diff);
-            entry << "SUBTRACT: " << ins.args[0] << " = " << ins.args[1] << " - " << ins.args[2]
-                << " -> " << diff;
-        }
+    case OpCode::SLEEP:
         break;
-    case InstructionType::SLEEP:
-        if (!ins.args.empty()) {
-            entry << "SLEEP: " << ins.args[0] << " ticks";
-            std::this_thread::sleep_for(std::chrono::milliseconds(std::stoi(ins.args[0]) * 10));
-        }
+    default:
+        return true;
+    }
+    if (op.flags & kLhsIsRegister) slots[count++] = op.lhs;
+    if (op.flags & kRhsIsRegister) slots[count++] = op.rhs;
+    return count == 0 || pages->prepare(slots, count, written);
+}
+
+// Executes the op at pc, advances pc and records a log entry. Returns false for
+// ops that do not consume a CPU cycle.
+bool Process::executeOp(const Op& op, uint64_t tick) {
+    bool lhsReg = (op.flags & kLhsIsRegister) != 0;
+    bool rhsReg = (op.flags & kRhsIsRegister) != 0;
+    uint32_t next = pc + 1;
+
+    LogEntry entry{ tick, pc, static_cast<int16_t>(assignedCore.load(std::memory_order_relaxed)), LogKind::EXECUTED, op.code, 0, 0, 0 };
+
+    switch (op.code) {
+    case OpCode::PRINT:
         break;
-    case InstructionType::FOR:
-        entry << "FOR: repeat " << ins.repeatCount << " times {";
-        logs.push_back(entry.str());
-        for (int i = 0; i < ins.repeatCount; ++i) {
-            logs.push_back("  [FOR iteration " + std::to_string(i + 1) + "]");
-            for (const auto& subIns : ins.body) {
-                executeInstruction(subIns);
-            }
+    case OpCode::DECLARE:
+        entry.lhs = operandValue(op.lhs, lhsReg);
+        entry.result = entry.lhs;
+        variable(op.dst) = entry.result;
+        break;
+    case OpCode::ADD: {
+        entry.lhs = operandValue(op.lhs, lhsReg);
+        entry.rhs = operandValue(op.rhs, rhsReg);
+        int sum = std::clamp(entry.lhs + entry.rhs, 0, static_cast<int>(UINT16_MAX));
+        entry.result = static_cast<uint16_t>(sum);
+        variable(op.dst) = entry.result;
+        break;
+    }
+    case OpCode::SUBTRACT: {
+        entry.lhs = operandValue(op.lhs, lhsReg);
+        entry.rhs = operandValue(op.rhs, rhsReg);
+        int diff = std::clamp(entry.lhs - entry.rhs, 0, static_cast<int>(UINT16_MAX));
+        entry.result = static_cast<uint16_t>(diff);
+        variable(op.dst) = entry.result;
+        break;
+    }
+    case OpCode::SLEEP:
+        entry.result = operandValue(op.lhs, lhsReg);
+        wakeTick.store(tick + entry.result, std::memory_order_relaxed);
+        sleepRequested = entry.result > 0;
+        break;
+    case OpCode::LOOP_BEGIN:
+        entry.result = op.lhs;
+        logs.push(entry);
+        entry.kind = LogKind::LOOP_ITERATION;
+        if (op.lhs == 0) {
+            entry.kind = LogKind::LOOP_ENDED;
+            next = op.jump + 1;
+            if (program->code[op.jump].flags & kEndsLine) advanceLine();
+        }
+        else {
+            loopRemaining.push_back(op.lhs);
+            entry.result = 1;
         }
-        logs.push_back("  [FOR loop ended] };");
-        return;
+        logs.push(entry);
+        pc = next;
+        return true;
+    case OpCode::LOOP_END: {
+        uint16_t& remaining = loopRemaining.back();
+        if (--remaining > 0) {
+            entry.kind = LogKind::LOOP_ITERATION;
+            entry.result = static_cast<uint16_t>(program->code[op.jump].lhs - remaining + 1);
+            logs.push(entry);
+            pc = op.jump + 1;
+            return false;
+        }
+        loopRemaining.pop_back();
+        entry.kind = LogKind::LOOP_ENDED;
+        logs.push(entry);
+        if (op.flags & kEndsLine) advanceLine();
+        pc = next;
+        return false;
+    }
+    default:
+        break;
+    }
 
+    logs.push(entry);
+    if (op.flags & kEndsLine) advanceLine();
+    pc = next;
+    return true;
+}
 
+uint64_t Process::readLogs(uint64_t& cursor, std::vector<std::string>& out) const {
+    // Copy the small fixed-size records out first so the worker is never
+    // blocked on the ring's lock while text is being formatted
+    std::vector<LogEntry> entries;
+    uint64_t dropped = logs.readSince(cursor, entries);
+    out.reserve(out.size() + entries.size());
+    for (const auto& entry : entries) {
+        out.push_back(formatLog(entry));
+    }
+    return dropped;
+}
+
+std::string Process::formatLog(const LogEntry& entry) const {
+    if (entry.kind == LogKind::LOOP_ITERATION) {
+        return "  [FOR iteration " + std::to_string(entry.result) + "]";
+    }
+    if (entry.kind == LogKind::LOOP_ENDED) {
+        return "  [FOR loop ended] };";
+    }
+
+    const Op& op = program->code[entry.pc];
+    bool lhsReg = (op.flags & kLhsIsRegister) != 0;
+    bool rhsReg = (op.flags & kRhsIsRegister) != 0;
+
+    std::ostringstream text;
+    text << "[tick " << entry.tick << "] Core:" << entry.core << " ";
+
+    switch (entry.opcode) {
+    case OpCode::PRINT:
+        text << "PRINT: Hello world from " << name << "!";
+        break;
+    case OpCode::DECLARE:
+        text << "DECLARE: " << program->symbols.nameOf(op.dst) << " = " << operandText(op.lhs, lhsReg);
+        break;
+    case OpCode::ADD:
+        text << "ADD: " << program->symbols.nameOf(op.dst) << " = " << operandText(op.lhs, lhsReg)
+            << " + " << operandText(op.rhs, rhsReg) << " -> " << entry.result;
+        break;
+    case OpCode::SUBTRACT:
+        text << "SUBTRACT: " << program->symbols.nameOf(op.dst) << " = " << operandText(op.lhs, lhsReg)
+            << " - " << operandText(op.rhs, rhsReg) << " -> " << entry.result;
+        break;
+    case OpCode::SLEEP:
+        text << "SLEEP: " << entry.result << " ticks";
+        break;
+    case OpCode::LOOP_BEGIN:
+        text << "FOR: repeat " << entry.result << " times {";
+        break;
     default:
         break;
     }
-
-    logs.push_back(entry.str());
+    return text.str();
 }
 
-uint16_t Process::getValue(const std::string& arg) {
-    if (memory.count(arg)) return memory[arg];
-    return static_cast<uint16_t>(std::stoi(arg));
+std::string Process::operandText(uint16_t operand, bool isRegister) const {
+    return isRegister ? program->symbols.nameOf(operand) : std::to_string(operand);
 }
 
 std::string Process::getName() const { return name; }
-int Process::getAssignedCore() const { return assignedCore; }
-int Process::getCurrentLine() const { return currentLine; }
-int Process::getTotalLines() const { return static_cast<int>(instructions.size()); }
+int Process::getAssignedCore() const { return assignedCore.load(std::memory_order_relaxed); }
+int Process::getCurrentLine() const { return currentLine.load(std::memory_order_relaxed); }
+int Process::getTotalLines() const { return program->lineCount; }
 int Process::getId() const { return id; }
+
+ProcessTimes Process::getTimes() const {
+    ProcessTimes times;
+    times.started = started.load(std::memory_order_acquire);
+    times.arrival = arrivalTick.load(std::memory_order_relaxed);
+    times.firstRun = firstRunTick.load(std::memory_order_relaxed);
+    times.finish = finishTick.load(std::memory_order_relaxed);
+    times.waiting = waitingTicks.load(std::memory_order_relaxed);
+    times.cpu = cpuTicks.load(std::memory_order_relaxed);
+    return times;
+}
@@ -1,45 +1,206 @@
 #pragma once
 #include <string>
 #include <vector>
-#include <unordered_map>
 #include <atomic>
+#include <memory>
 #include "Instruction.h"
+#include "Bytecode.h"
+#include "LogRing.h"
+#include "LogEntry.h"
+#include "CpuClock.h"
+#include "MemoryManager.h"
 
-class Process {
+class Process;
+
+// Takes the log entries a running process has not handed over yet, before its
+// ring buffer overwrites them (log persistence). Called by the core running
+// the process whenever half the ring is pending.
+class LogDrain {
+public:
+    virtual ~LogDrain() = default;
+    virtual void drain(int coreId, Process& proc) = 0;
+};
+
+// Why Process::run returned control to the scheduler
+enum class RunResult {
+    FINISHED,       // executed its last instruction
+    PREEMPTED,      // used up its quantum or was preempted by the scheduler
+    SLEEPING,       // executed SLEEP; must not run again before getWakeTick()
+    STOPPED         // the scheduler is shutting down
+};
+
+// Where a process is in its lifecycle; set by the mark*() calls below
+enum class ProcessState {
+    READY,      // in a ready queue
+    RUNNING,    // on a core
+    WAITING,    // parked by SLEEP until its wake tick
+    FINISHED
+};
+
+// Bookkeeping that belongs to the scheduling policy (mlfq priority level and
+// accounting). Only the thread that currently holds the process touches it.
+struct PolicyState {
+    int level = 0;
+    uint64_t epoch = 0;             // policy aging epoch the level was set in
+    uint64_t cpuAtDispatch = 0;     // getCpuTicks() when last dispatched
+    uint64_t queuedAt = 0;          // tick of the last push into a ready queue
+};
+
+// Lifetime of a process in CPU clock ticks, as returned by Process::getTimes()
+struct ProcessTimes {
+    uint64_t arrival = 0;
+    uint64_t firstRun = 0;      // valid if started
+    uint64_t finish = 0;        // valid once finished
+    uint64_t waiting = 0;       // total ticks spent in a ready queue
+    uint64_t cpu = 0;           // ticks spent executing instructions
+    bool started = false;
+};
+
+class Process : public std::enable_shared_from_this<Process> {
 public:
-    Process(int id, const std::string& name, const std::vector<Instruction>& instructions);
+    Process(int id, const std::string& name, const std::vector<Instruction>& instructions,
+        size_t maxVariables = 0, size_t logCapacity = 256);
+
+    // Runs a compiled program that may be shared with other processes; only
+    // registers, loop counters and logs are per process
+    Process(int id, const std::string& name, std::shared_ptr<const Program> program, size_t logCapacity = 256);
+
+    // Allocates the process and its shared_ptr control block from a pool that
+    // recycles the memory of destroyed processes
+    static std::shared_ptr<Process> create(int id, const std::string& name, const std::vector<Instruction>& instructions,
+        size_t maxVariables = 0, size_t logCapacity = 256);
+    static std::shared_ptr<Process> create(int id, const std::string& name, std::shared_ptr<const Program> program,
+        size_t logCapacity = 256);
 
-    void run(int coreId, int delayPerExecution, int quantum, std::atomic<bool>& running); // quantum = 0 for fcfs, >0 for round-robin
+    // quantum = 0 for fcfs, >0 for round-robin; preempt (optional) is raised by the scheduler to take the core away;
+    // drain (optional) receives pending log entries during long bursts
+    RunResult run(int coreId, int delayPerExecution, int quantum, std::atomic<bool>& running, CpuClock& clock,
+        const std::atomic<bool>* preempt = nullptr, LogDrain* drain = nullptr);
+
+    // Executes the next instruction at the given tick without touching the clock
+    // (lockstep simulation). PREEMPTED means there is more to run; quanta and
+    // preemption are up to the caller.
+    RunResult step(int coreId, uint64_t tick, LogDrain* drain = nullptr);
     std::string getTimestamp() const;
     std::string getName() const;
     int getAssignedCore() const;
     int getCurrentLine() const;
     int getTotalLines() const;
     int getId() const;
+    int getContextSwitches() const { return contextSwitches.load(std::memory_order_relaxed); }
+    uint64_t getCpuTicks() const { return cpuTicks.load(std::memory_order_relaxed); }
+    uint64_t getWakeTick() const { return wakeTick.load(std::memory_order_relaxed); }
+    const std::shared_ptr<const Program>& getProgram() const { return program; }
+
+    // Moves the variables into demand-paged memory; only before the first run
+    void attachMemory(std::shared_ptr<MemoryManager> memory);
+    // Returns the frames and backing store slots once the process is done
+    void releaseMemory() { pages.reset(); }
+    PageTable* getPageTable() const { return pages.get(); }
+
+    PolicyState& getPolicyState() { return policyState; }
+    const PolicyState& getPolicyState() const { return policyState; }
+
+    // Called by the scheduler when the process is preempted and requeued
+    void recordContextSwitch() { contextSwitches.store(getContextSwitches() + 1, std::memory_order_relaxed); }
+    void releaseCore() { assignedCore.store(-1, std::memory_order_relaxed); }
+
+    // Scheduler bookkeeping for turnaround, waiting and response times. Only the
+    // thread that currently owns the process calls these; the console may read
+    // getTimes() at any time.
+    void markArrived(uint64_t tick) {
+        arrivalTick.store(tick, std::memory_order_relaxed);
+        readySince = tick;
+    }
+    void markReady(uint64_t tick) {
+        readySince = tick;
+        state.store(ProcessState::READY, std::memory_order_relaxed);
+    }
+    void markWaiting() { state.store(ProcessState::WAITING, std::memory_order_relaxed); }
+    // Returns the ticks spent ready since markArrived/markReady
+    uint64_t markDispatched(uint64_t tick) {
+        uint64_t waited = tick - readySince;
+        state.store(ProcessState::RUNNING, std::memory_order_relaxed);
+        waitingTicks.store(waitingTicks.load(std::memory_order_relaxed) + waited, std::memory_order_relaxed);
+        if (!started.load(std::memory_order_relaxed)) {
+            firstRunTick.store(tick, std::memory_order_relaxed);
+            started.store(true, std::memory_order_release);
+        }
+        return waited;
+    }
+    void markFinished(uint64_t tick) {
+        finishTick.store(tick, std::memory_order_relaxed);
+        state.store(ProcessState::FINISHED, std::memory_order_release);
+    }
+    ProcessTimes getTimes() const;
+    ProcessState getState() const { return state.load(std::memory_order_acquire); }
 
-    std::vector<std::string> getLogs() const { return logs; }
+    // Appends log entries from cursor onwards to out and advances cursor. Safe to
+    // call while the process runs; returns how many entries were already overwritten.
+    uint64_t readLogs(uint64_t& cursor, std::vector<std::string>& out) const;
+    uint64_t readLogEntries(uint64_t& cursor, std::vector<LogEntry>& out) const { return logs.readSince(cursor, out); }
+    // Log persistence: appends what was logged since the previous call. Only
+    // the thread that currently owns the process calls this.
+    uint64_t takeNewLogs(std::vector<LogEntry>& out) { return logs.readSince(persistedLogs, out); }
+    uint64_t getPersistedLogs() const { return persistedLogs; }
+    std::string formatLog(const LogEntry& entry) const;
 
     bool isFinished() const {
-        return currentLine >= instructions.size();
+        return pc >= program->code.size();
     }
 
 
 
 private:
 
-    std::vector<std::string> logs;
+    LogRing<LogEntry> logs;
     std::string creationTimestamp;
     std::string generateTimestamp() const;
     std::string name;
     int id;
-    std::vector<Instruction> instructions;
-    std::unordered_map<std::string, uint16_t> memory;
-    int currentLine;
-    int assignedCore;
+    std::shared_ptr<const Program> program;    // immutable, possibly shared with other processes
+    std::vector<uint16_t> registers;        // fixed-size variable store, indexed by symbol slot
+    std::unique_ptr<PageTable> pages;       // replaces registers when memory is paged
+    PolicyState policyState;
+    std::vector<uint16_t> loopRemaining;    // iterations left for each active FOR
+    uint32_t pc;                            // index of the next op in program.code
+    std::atomic<int> currentLine;   // read by the scheduler (srtf) and console while the process runs
+    std::atomic<int> assignedCore;
+    std::atomic<ProcessState> state{ ProcessState::READY };
+    std::atomic<int> contextSwitches{ 0 };
+    std::atomic<uint64_t> wakeTick{ 0 };    // tick at which the last SLEEP ends; read by the console
+
+    // Tick bookkeeping, see markArrived()..markFinished()
+    std::atomic<uint64_t> arrivalTick{ 0 };
+    std::atomic<uint64_t> firstRunTick{ 0 };
+    std::atomic<uint64_t> finishTick{ 0 };
+    std::atomic<uint64_t> waitingTicks{ 0 };
+    std::atomic<uint64_t> cpuTicks{ 0 };
+    std::atomic<bool> started{ false };
+    uint64_t readySince = 0;
+    uint64_t persistedLogs = 0;     // log cursor of takeNewLogs()
+    bool sleepRequested = false;    // set by SLEEP, makes run() yield the core
 	std::string timestamp;
 
-    void executeInstruction(const Instruction& ins);
-    uint16_t getValue(const std::string& arg);
+    bool executeOp(const Op& op, uint64_t tick);
+    void drainLogs(int coreId, LogDrain* drain) {
+        // An op logs at most two entries, so half the ring leaves room until the next check
+        if (!drain) return;
+        uint64_t pending = logs.pushedSoFar() - persistedLogs;
+        if (pending > 0 && pending >= logs.getCapacity() / 2) drain->drain(coreId, *this);
+    }
+    bool pageIn(const Op& op);
+    uint16_t& variable(uint16_t slot) {
+        return pages ? pages->word(slot) : registers[slot];
+    }
+    void advanceLine() {
+        // Only the running core writes currentLine, so a plain load/store is enough
+        currentLine.store(currentLine.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+    uint16_t operandValue(uint16_t operand, bool isRegister) {
+        return isRegister ? variable(operand) : operand;
+    }
+    std::string operandText(uint16_t operand, bool isRegister) const;
     
 
 };
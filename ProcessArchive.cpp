@@ -0,0 +1,80 @@
+#include "ProcessArchive.h"
+
+ProcessArchive::~ProcessArchive() {
+    close();
+}
+
+bool ProcessArchive::open(const std::string& newPath) {
+    close();
+    path = newPath;
+    if (path.empty()) return true;
+
+    file.open(path, std::ios::app);
+    if (!file.is_open()) return false;
+    stopping = false;
+    opened = true;
+    thread = std::thread(&ProcessArchive::run, this);
+    return true;
+}
+
+void ProcessArchive::close() {
+    if (thread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+            opened = false;
+        }
+        wake.notify_all();
+        thread.join();     // queued processes are written on the way out
+    }
+    if (file.is_open()) file.close();
+}
+
+void ProcessArchive::append(std::shared_ptr<Process> proc) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!opened) return;
+        pending.push_back(std::move(proc));
+    }
+    wake.notify_one();
+}
+
+void ProcessArchive::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wake.wait(lock, [&] { return stopping || !pending.empty(); });
+        if (pending.empty()) break;     // stopping with nothing left
+        taken.swap(pending);
+        lock.unlock();
+
+        for (const auto& proc : taken) {
+            format(*proc);
+        }
+        taken.clear();  // may release the last reference to a process
+        file << text;
+        file.flush();
+        text.clear();
+
+        lock.lock();
+    }
+}
+
+void ProcessArchive::format(const Process& proc) {
+    ProcessTimes times = proc.getTimes();
+    std::vector<std::string> lines;
+    uint64_t cursor = 0;
+    uint64_t dropped = proc.readLogs(cursor, lines);
+
+    text += "=== " + proc.getName() + " (id " + std::to_string(proc.getId()) + ") created "
+        + proc.getTimestamp() + " | " + std::to_string(proc.getTotalLines()) + " lines"
+        + " | arrival " + std::to_string(times.arrival) + " first-run " + std::to_string(times.firstRun)
+        + " finish " + std::to_string(times.finish) + " waiting " + std::to_string(times.waiting)
+        + " cpu " + std::to_string(times.cpu) + " switches " + std::to_string(proc.getContextSwitches()) + "\n";
+    if (dropped > 0) {
+        text += "... " + std::to_string(dropped) + " older log entries discarded ...\n";
+    }
+    for (const auto& line : lines) {
+        text += line;
+        text += '\n';
+    }
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include "Process.h"
+#include <atomic>
+#include <condition_variable>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Append-only text file that finished processes are spilled to when they fall
+// out of the in-memory retention window (config key "archive-file"). Each
+// record is a summary line followed by the log lines the process still held.
+// Cores only queue the process; a background thread formats the records and
+// writes each batch with a single flush.
+class ProcessArchive {
+public:
+    ~ProcessArchive();
+
+    // Writes out and stops any previous file first. Empty path disables
+    // archiving. Returns false if the file cannot be opened.
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return opened.load(std::memory_order_relaxed); }
+    const std::string& getPath() const { return path; }
+
+    void append(std::shared_ptr<Process> proc);
+
+private:
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::vector<std::shared_ptr<Process>> pending;     // queued by the cores
+    bool stopping = false;
+    std::atomic<bool> opened{ false };
+    std::thread thread;
+    std::string path;
+
+    // Only touched by the writer thread (and open/close while it is not running)
+    std::ofstream file;
+    std::vector<std::shared_ptr<Process>> taken;
+    std::string text;
+
+    void run();
+    void format(const Process& proc);
+};
@@ -0,0 +1,49 @@
+#include "ProcessTable.h"
+#include <mutex>
+
+void ProcessTable::insert(const std::shared_ptr<Process>& proc) {
+    std::string name = proc->getName();
+    {
+        Shard<int>& shard = byId[shardOf(proc->getId())];
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        if (shard.entries.emplace(proc->getId(), proc).second) {
+            count.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    Shard<std::string>& shard = byName[shardOf(name)];
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    shard.entries[name] = proc;
+}
+
+void ProcessTable::erase(const Process& proc) {
+    std::string name = proc.getName();
+    {
+        Shard<int>& shard = byId[shardOf(proc.getId())];
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.entries.find(proc.getId());
+        if (it != shard.entries.end() && it->second.get() == &proc) {
+            shard.entries.erase(it);
+            count.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+    Shard<std::string>& shard = byName[shardOf(name)];
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.entries.find(name);
+    if (it != shard.entries.end() && it->second.get() == &proc) {
+        shard.entries.erase(it);
+    }
+}
+
+std::shared_ptr<Process> ProcessTable::findByName(const std::string& name) const {
+    const Shard<std::string>& shard = byName[shardOf(name)];
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.entries.find(name);
+    return it != shard.entries.end() ? it->second : nullptr;
+}
+
+std::shared_ptr<Process> ProcessTable::findById(int id) const {
+    const Shard<int>& shard = byId[shardOf(id)];
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.entries.find(id);
+    return it != shard.entries.end() ? it->second : nullptr;
+}
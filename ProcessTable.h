@@ -0,0 +1,48 @@
+#pragma once
+#include "Process.h"
+#include <array>
+#include <atomic>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+// Every process from creation until it leaves finished-process retention,
+// indexed by name and by PID for screen -s and screen -r. Each index is split
+// into kShards hash shards with their own reader-writer lock, so lookups run
+// in parallel and only wait for an insert or erase in the same shard. Writers
+// are the dispatcher, which inserts on admit, and the core that finishes a
+// process, which erases the one pushed out of retention; each holds one
+// shard's lock per index for a single map update. Dispatching, requeueing and
+// sleeping never touch the table: a process's scheduling state lives in the
+// process itself (Process::getState), so it keeps its entries while it moves
+// between ready, running, waiting and finished.
+class ProcessTable {
+public:
+    // A newer process with the same name takes over the name; the older one
+    // stays reachable by PID
+    void insert(const std::shared_ptr<Process>& proc);
+    void erase(const Process& proc);
+
+    std::shared_ptr<Process> findByName(const std::string& name) const;
+    std::shared_ptr<Process> findById(int id) const;
+
+    size_t size() const { return count.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr size_t kShards = 16;
+
+    template <typename Key>
+    struct Shard {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<Key, std::shared_ptr<Process>> entries;
+    };
+
+    std::array<Shard<std::string>, kShards> byName;
+    std::array<Shard<int>, kShards> byId;
+    std::atomic<size_t> count{ 0 };     // processes in byId
+
+    static size_t shardOf(const std::string& name) { return std::hash<std::string>{}(name) % kShards; }
+    // PIDs are sequential, so consecutive processes land in different shards
+    static size_t shardOf(int id) { return static_cast<size_t>(id) % kShards; }
+};
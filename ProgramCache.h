@@ -0,0 +1,63 @@
+#pragma once
+#include "Bytecode.h"
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+// Compiled programs shared by every process generated with the same
+// parameters. Programs are immutable once published, so processes hold them
+// by shared_ptr and spawning another copy costs only a new PCB and registers.
+class ProgramCache {
+public:
+    struct Key {
+        int minInstructions;
+        int maxInstructions;
+        size_t maxVariables;
+        int variant;        // which of the program-variants programs for these parameters
+
+        bool operator==(const Key& other) const {
+            return minInstructions == other.minInstructions && maxInstructions == other.maxInstructions
+                && maxVariables == other.maxVariables && variant == other.variant;
+        }
+    };
+
+    // Returns the cached program for key, calling build() (which returns a
+    // Program) outside the lock on a miss. If two threads miss at once, the
+    // first program published wins.
+    template <typename Build>
+    std::shared_ptr<const Program> getOrBuild(const Key& key, Build&& build) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = programs.find(key);
+            if (it != programs.end()) return it->second;
+        }
+        auto program = std::make_shared<const Program>(build());
+        std::lock_guard<std::mutex> lock(mutex);
+        return programs.emplace(key, std::move(program)).first->second;
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex);
+        programs.clear();
+    }
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return programs.size();
+    }
+
+private:
+    struct KeyHash {
+        size_t operator()(const Key& key) const {
+            size_t h = std::hash<int>{}(key.minInstructions);
+            h = h * 31 + std::hash<int>{}(key.maxInstructions);
+            h = h * 31 + std::hash<size_t>{}(key.maxVariables);
+            return h * 31 + std::hash<int>{}(key.variant);
+        }
+    };
+
+    mutable std::mutex mutex;
+    std::unordered_map<Key, std::shared_ptr<const Program>, KeyHash> programs;
+};
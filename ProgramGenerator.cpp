@@ -0,0 +1,164 @@
+#include "ProgramGenerator.h"
+#include <algorithm>
+#include <string>
+
+ProgramGenerator::~ProgramGenerator() {
+    stop();
+}
+
+void ProgramGenerator::reset(const Params& newParams, ProgramCache* newCache) {
+    std::lock_guard<std::mutex> lock(mutex);
+    params = newParams;
+    cache = newCache;
+    nextToClaim = 0;
+    nextToTake = 0;
+    for (auto& slot : slots) slot = Slot();
+}
+
+void ProgramGenerator::start(int threads, size_t capacity) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = false;
+        slots.assign(std::max<size_t>(capacity, 1), Slot());
+        nextToClaim = nextToTake;   // programs built before the last stop were discarded
+    }
+    for (int i = 0; i < std::max(threads, 1); ++i) {
+        workers.emplace_back(&ProgramGenerator::worker, this);
+    }
+}
+
+void ProgramGenerator::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    built.notify_all();
+    freed.notify_all();
+    for (auto& t : workers) {
+        if (t.joinable()) t.join();
+    }
+    workers.clear();
+}
+
+std::shared_ptr<const Program> ProgramGenerator::next() {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (slots.empty()) return nullptr;
+    Slot* slot = nullptr;
+    built.wait(lock, [&] {
+        slot = &slots[nextToTake % slots.size()];
+        return stopping || (slot->ready && slot->index == nextToTake);
+    });
+    if (stopping) return nullptr;
+
+    auto program = std::move(slot->program);
+    slot->ready = false;
+    ++nextToTake;
+    lock.unlock();
+    freed.notify_one();
+    return program;
+}
+
+void ProgramGenerator::worker() {
+    while (true) {
+        uint64_t index;
+        {
+            // Never run more than a buffer's worth ahead of the dispatcher
+            std::unique_lock<std::mutex> lock(mutex);
+            freed.wait(lock, [&] { return stopping || nextToClaim < nextToTake + slots.size(); });
+            if (stopping) return;
+            index = nextToClaim++;
+        }
+
+        auto program = build(kBatchStream, index);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (stopping) return;
+            Slot& slot = slots[index % slots.size()];
+            slot.program = std::move(program);
+            slot.index = index;
+            slot.ready = true;
+        }
+        built.notify_all();
+    }
+}
+
+std::shared_ptr<const Program> ProgramGenerator::build(uint64_t stream, uint64_t index) const {
+    auto compile = [this](Rng& rng) {
+        int numInstructions = params.minInstructions;
+        if (params.maxInstructions > params.minInstructions) {
+            numInstructions += static_cast<int>(rng() % (params.maxInstructions - params.minInstructions + 1));
+        }
+        return Program::compile(generateInstructions(rng, numInstructions), params.maxVariables);
+    };
+
+    Rng rng(seedFor(params.seed, stream, index));
+    if (params.variants <= 0 || !cache) {
+        return std::make_shared<const Program>(compile(rng));
+    }
+
+    // Shared programs are seeded by variant, so every process drawing the same variant gets the same program
+    int variant = static_cast<int>(rng() % params.variants);
+    ProgramCache::Key key{ params.minInstructions, params.maxInstructions, params.maxVariables, variant };
+    return cache->getOrBuild(key, [&] {
+        Rng variantRng(seedFor(params.seed, kVariantStream, static_cast<uint64_t>(variant)));
+        return compile(variantRng);
+    });
+}
+
+// splitmix64 finalizer over (seed, stream, index), so nearby indices get unrelated seeds
+uint64_t ProgramGenerator::seedFor(uint64_t seed, uint64_t stream, uint64_t index) {
+    uint64_t z = seed + 0x9E3779B97F4A7C15ULL * (index + 1) + 0xD1B54A32D192ED03ULL * stream;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// mt19937_64 output is fixed by the standard (unlike the distributions), so a
+// seed reproduces the same programs on every compiler
+std::vector<Instruction> ProgramGenerator::generateInstructions(Rng& rng, int count, int depth) {
+    std::vector<Instruction> instructions;
+    instructions.reserve(count);
+	const int maxDepth = 3; // (depth=the number of nested for loops)
+
+    for (int i = 0; i < count; ++i) {
+        int choice = static_cast<int>(rng() % 6);
+
+        switch (choice) {
+        case 0: // PRINT
+            instructions.emplace_back(InstructionType::PRINT);
+            break;
+        case 1: // DECLARE
+            instructions.emplace_back(InstructionType::DECLARE, std::vector<std::string>{"var" + std::to_string(i), "10"});
+            break;
+        case 2: // ADD
+            instructions.emplace_back(InstructionType::ADD, std::vector<std::string>{"var" + std::to_string(i), "1", "2"});
+            break;
+        case 3: // SUBTRACT
+            instructions.emplace_back(InstructionType::SUBTRACT, std::vector<std::string>{"var" + std::to_string(i), "5", "3"});
+            break;
+        case 4: // SLEEP
+            instructions.emplace_back(InstructionType::SLEEP, std::vector<std::string>{"1"});
+            break;
+        case 5: { // FOR loop
+            if (depth < maxDepth) {
+                int repeats = 2 + static_cast<int>(rng() % 3);   // repeat 2-4 times (repeats=the number of times for loop will repeat)
+                int bodySize = 2 + static_cast<int>(rng() % 3);  // body has 2-4 instructions (body=the number of instructions in the for loop)
+                instructions.emplace_back(InstructionType::FOR);
+                instructions.back().repeatCount = repeats;
+                instructions.back().body = generateInstructions(rng, bodySize, depth + 1);
+            }
+            else {
+                // depth limit reached, so just do print
+                instructions.emplace_back(InstructionType::PRINT);
+            }
+            break;
+        default:
+            instructions.emplace_back(InstructionType::PRINT);
+            break;
+        }
+        }
+    }
+
+    return instructions;
+}
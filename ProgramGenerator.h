@@ -0,0 +1,75 @@
+#pragma once
+#include "Bytecode.h"
+#include "Instruction.h"
+#include "ProgramCache.h"
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+// Builds programs for batch processes on background threads. Program i is
+// generated from its own RNG seeded with (seed, i), so the dispatcher receives
+// the same sequence of programs for a given seed no matter how many threads
+// build them or in which order they finish. Built programs wait in a bounded
+// reorder buffer until the dispatcher takes them in sequence order.
+class ProgramGenerator {
+public:
+    using Rng = std::mt19937_64;
+
+    struct Params {
+        int minInstructions = 1000;
+        int maxInstructions = 2000;
+        size_t maxVariables = 0;    // 0 = unlimited
+        int variants = 0;       // > 0: draw from this many shared programs through the cache
+        uint64_t seed = 1;
+    };
+
+    // Independent program sequences derived from one seed
+    static constexpr uint64_t kBatchStream = 0;
+    static constexpr uint64_t kManualStream = 1;
+    static constexpr uint64_t kVariantStream = 2;
+
+    ~ProgramGenerator();
+
+    // Only while stopped. Sets the parameters and restarts the sequence at program 0.
+    void reset(const Params& params, ProgramCache* cache);
+
+    void start(int threads, size_t capacity);
+
+    // Joins the workers; the sequence resumes where the dispatcher left off on the next start()
+    void stop();
+
+    // Next program in sequence order; blocks until it is built. Returns nullptr once stopped.
+    std::shared_ptr<const Program> next();
+
+    // Builds program `index` of `stream` on the calling thread
+    std::shared_ptr<const Program> build(uint64_t stream, uint64_t index) const;
+
+    // Random instruction list as generated for batch processes
+    static std::vector<Instruction> generateInstructions(Rng& rng, int count, int depth = 0);
+
+private:
+    struct Slot {
+        std::shared_ptr<const Program> program;
+        uint64_t index = 0;
+        bool ready = false;
+    };
+
+    Params params;
+    ProgramCache* cache = nullptr;
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable built;      // a slot became ready
+    std::condition_variable freed;      // the dispatcher took a slot
+    std::vector<Slot> slots;            // program i waits in slots[i % slots.size()]
+    uint64_t nextToClaim = 0;           // next index a worker will build
+    uint64_t nextToTake = 0;            // next index the dispatcher will take
+    bool stopping = false;
+
+    void worker();
+    static uint64_t seedFor(uint64_t seed, uint64_t stream, uint64_t index);
+};
@@ -0,0 +1,156 @@
+#include "QuantumTuner.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+
+bool QuantumTuner::configure(bool newEnabled, int initial, int newMinQuantum, int newMaxQuantum, uint64_t newTargetWait,
+    bool newMeasureOverhead, const std::string& newLogPath) {
+    // Changes from the previous run go to the previous log
+    flush();
+    std::lock_guard<std::mutex> logLock(logMutex);
+    std::lock_guard<std::mutex> lock(mutex);
+    enabled = newEnabled;
+    measureOverhead = newMeasureOverhead;
+    minQuantum = std::max(newMinQuantum, 1);
+    maxQuantum = std::max(newMaxQuantum, minQuantum);
+    targetWait = newTargetWait;
+    quantum.store(std::clamp(initial, minQuantum, maxQuantum), std::memory_order_relaxed);
+
+    dispatches.store(0, std::memory_order_relaxed);
+    waitSum.store(0, std::memory_order_relaxed);
+    bursts.store(0, std::memory_order_relaxed);
+    switchNanosSum.store(0, std::memory_order_relaxed);
+    burstNanosSum.store(0, std::memory_order_relaxed);
+    cyclesSum.store(0, std::memory_order_relaxed);
+    changeCount = 0;
+    recent.clear();
+    overheadFloor = 0;
+
+    if (log.is_open()) log.close();
+    logPath = newLogPath;
+    if (!enabled || logPath.empty()) {
+        logging = false;
+        return true;
+    }
+    log.open(logPath, std::ios::trunc);
+    logging = log.is_open();
+    return logging;
+}
+
+void QuantumTuner::close() {
+    flush();
+    std::lock_guard<std::mutex> logLock(logMutex);
+    std::lock_guard<std::mutex> lock(mutex);
+    logging = false;
+    if (log.is_open()) log.close();
+}
+
+void QuantumTuner::flush() {
+    std::lock_guard<std::mutex> logLock(logMutex);
+    std::vector<Change> batch;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        batch.swap(unwritten);
+    }
+    if (batch.empty() || !log.is_open()) return;
+    for (const Change& change : batch) {
+        writeChange(log, change);
+    }
+    log.flush();
+}
+
+int QuantumTuner::recordDispatch(uint64_t tick, uint64_t waitTicks) {
+    if (!enabled) return 0;
+    waitSum.fetch_add(waitTicks, std::memory_order_relaxed);
+    if (dispatches.fetch_add(1, std::memory_order_relaxed) + 1 < kWindow) return 0;
+
+    bool logFull = false;
+    int changed = closeWindow(tick, logFull);
+    // Outside mutex, so other cores can keep closing windows while this one writes
+    if (logFull) flush();
+    return changed;
+}
+
+// Sets logFull once kLogBatch changes are waiting for the log
+int QuantumTuner::closeWindow(uint64_t tick, bool& logFull) {
+    std::lock_guard<std::mutex> lock(mutex);
+    uint64_t count = dispatches.exchange(0, std::memory_order_relaxed);
+    if (count < kWindow) return 0;  // another core closed this window first
+    uint64_t averageWait = waitSum.exchange(0, std::memory_order_relaxed) / count;
+    int current = quantum.load(std::memory_order_relaxed);
+
+    // Wait per dispatch grows roughly in proportion to the quantum, so scale
+    // by target / measured, leaving a 10% band around the target alone
+    int wanted = current;
+    if (averageWait * 10 > targetWait * 11) {
+        double scale = std::max(static_cast<double>(targetWait) / static_cast<double>(averageWait), 0.5);
+        wanted = std::min(current - 1, static_cast<int>(std::lround(current * scale)));
+    }
+    else if (averageWait * 10 < targetWait * 9) {
+        double scale = averageWait > 0 ? std::min(static_cast<double>(targetWait) / static_cast<double>(averageWait), 2.0) : 2.0;
+        wanted = std::max(current + 1, static_cast<int>(std::lround(current * scale)));
+    }
+
+    double share = 0;
+    if (measureOverhead) {
+        uint64_t n = bursts.exchange(0, std::memory_order_relaxed);
+        uint64_t switchNanos = switchNanosSum.exchange(0, std::memory_order_relaxed);
+        uint64_t burstNanos = burstNanosSum.exchange(0, std::memory_order_relaxed);
+        uint64_t cycles = cyclesSum.exchange(0, std::memory_order_relaxed);
+        if (n > 0 && cycles > 0 && burstNanos > 0) {
+            share = static_cast<double>(switchNanos) / static_cast<double>(switchNanos + burstNanos);
+            // Smallest q with perSwitch / (perSwitch + q * perCycle) <= kMaxSwitchShare
+            double perSwitch = static_cast<double>(switchNanos) / static_cast<double>(n);
+            double perCycle = static_cast<double>(burstNanos) / static_cast<double>(cycles);
+            double floor = std::ceil(perSwitch * (1 - kMaxSwitchShare) / (kMaxSwitchShare * perCycle));
+            overheadFloor = static_cast<int>(std::min(floor, static_cast<double>(maxQuantum)));
+        }
+    }
+
+    wanted = std::clamp(wanted, std::max(minQuantum, overheadFloor), maxQuantum);
+    if (wanted == current) return 0;
+    quantum.store(wanted, std::memory_order_relaxed);
+
+    Change change;
+    change.tick = tick;
+    change.from = current;
+    change.to = wanted;
+    change.averageWait = averageWait;
+    change.switchShare = share;
+    ++changeCount;
+    recent.push_back(change);
+    if (recent.size() > kRecentChanges) recent.pop_front();
+
+    if (logging) {
+        unwritten.push_back(change);
+        logFull = unwritten.size() >= kLogBatch;
+    }
+    return wanted;
+}
+
+// Requires mutex or logMutex: the settings it reads only change in configure(), which holds both
+void QuantumTuner::writeChange(std::ostream& out, const Change& change) const {
+    out << "tick " << change.tick << ": quantum " << change.from << " -> " << change.to
+        << " (average wait " << change.averageWait << " ticks, target " << targetWait;
+    if (measureOverhead) {
+        out << ", switching " << std::fixed << std::setprecision(1) << change.switchShare * 100 << "% of core time";
+        out.unsetf(std::ios::fixed);
+    }
+    out << ")\n";
+}
+
+void QuantumTuner::writeReport(std::ostream& out) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!enabled) return;
+    out << "\nAdaptive quantum: " << get() << " (range " << minQuantum << "-" << maxQuantum << ", target response "
+        << targetWait << " ticks), " << changeCount << " changes\n";
+    if (overheadFloor > 0) {
+        out << "Switch overhead floor: " << overheadFloor << " instructions\n";
+    }
+    if (!recent.empty()) {
+        out << "Recent changes:\n";
+        for (const Change& change : recent) {
+            writeChange(out, change);
+        }
+    }
+}
@@ -0,0 +1,96 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Adaptive round-robin quantum (config key quantum-mode "adaptive"). Every
+// kWindow dispatches it compares the average ready-queue wait per dispatch
+// with target-response and scales the quantum towards it, at most doubling or
+// halving it per window, within [quantum-min, quantum-max]. In threaded mode it
+// also times each dispatch and requeue on the host and never picks a quantum
+// so small that switching would take more than kMaxSwitchShare of core time.
+// Every change is appended to the quantum log: cores only buffer the record,
+// and flush() writes it out (report-util, scheduler-stop, or the core that
+// fills a batch of kLogBatch records).
+class QuantumTuner {
+public:
+    static constexpr uint64_t kWindow = 64;
+    static constexpr double kMaxSwitchShare = 0.10;
+    static constexpr size_t kLogBatch = 1024;
+
+    // One quantum change, as logged
+    struct Change {
+        uint64_t tick = 0;
+        int from = 0;
+        int to = 0;
+        uint64_t averageWait = 0;   // ticks per dispatch over the window
+        double switchShare = 0;     // measured share of core time spent switching, 0 if not measured
+    };
+
+    // Starts a run with the given quantum; measureOverhead is off in lockstep
+    // mode, where host timings would make runs differ. An empty logPath keeps
+    // changes in memory only. Returns false if the log cannot be opened.
+    bool configure(bool enabled, int initial, int minQuantum, int maxQuantum, uint64_t targetWait,
+        bool measureOverhead, const std::string& logPath);
+    void close();
+    // Writes the buffered changes to the quantum log
+    void flush();
+
+    bool isEnabled() const { return enabled; }
+    bool measuresOverhead() const { return enabled && measureOverhead; }
+    int get() const { return quantum.load(std::memory_order_relaxed); }
+
+    // Once per dispatch, with the ticks the process just spent in the ready
+    // queue. Returns the new quantum when this dispatch closed a window that
+    // changed it, otherwise 0.
+    int recordDispatch(uint64_t tick, uint64_t waitTicks);
+
+    // Host time spent putting a process on a core and taking it off again,
+    // and time spent running `cycles` instructions in between
+    void recordOverhead(uint64_t switchNanos, uint64_t burstNanos, uint64_t cycles) {
+        switchNanosSum.fetch_add(switchNanos, std::memory_order_relaxed);
+        burstNanosSum.fetch_add(burstNanos, std::memory_order_relaxed);
+        cyclesSum.fetch_add(cycles, std::memory_order_relaxed);
+        bursts.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void writeReport(std::ostream& out) const;
+
+private:
+    static constexpr size_t kRecentChanges = 8;    // shown by report-util
+
+    bool enabled = false;
+    bool measureOverhead = false;
+    int minQuantum = 1;
+    int maxQuantum = 1;
+    uint64_t targetWait = 0;
+    std::atomic<int> quantum{ 0 };
+
+    // Current window; a core that closes it takes the mutex and resets them
+    std::atomic<uint64_t> dispatches{ 0 };
+    std::atomic<uint64_t> waitSum{ 0 };
+    std::atomic<uint64_t> bursts{ 0 };
+    std::atomic<uint64_t> switchNanosSum{ 0 };
+    std::atomic<uint64_t> burstNanosSum{ 0 };
+    std::atomic<uint64_t> cyclesSum{ 0 };
+
+    mutable std::mutex mutex;
+    uint64_t changeCount = 0;
+    std::deque<Change> recent;
+    int overheadFloor = 0;      // smallest quantum within kMaxSwitchShare, from the last measured window
+    bool logging = false;
+    std::vector<Change> unwritten;  // changes not yet in the log
+
+    // Taken before mutex when both are needed, so batches reach the file in order
+    std::mutex logMutex;
+    std::ofstream log;
+    std::string logPath;
+
+    int closeWindow(uint64_t tick, bool& logFull);
+    void writeChange(std::ostream& out, const Change& change) const;
+};
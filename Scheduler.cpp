@@ -6,22 +6,56 @@
 #include <chrono>
 #include <ctime>
 #include <cstdlib>
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <random>
 
 Scheduler::Scheduler() : numCores(4),
 schedulerType("rr"),
 quantumCycles(5),
+quantumMode("fixed"),
+minQuantum(1),
+maxQuantum(50),
+targetResponse(100),
+quantumLogPath("csopesy-quantum-log.txt"),
 batchFrequency(1),
 minInstructions(1000),
 maxInstructions(2000),
 delayPerExecution(0),
+maxVariables(0),
+logCapacity(256),
+logPersist("off"),
+logFlushMs(100),
+logFsyncMs(1000),
+readyQueueMode("global"),
+mlfqLevels(3),
+mlfqAging(1000),
+programVariants(0),
+simulationMode("threaded"),
+seed(0),
+generatorThreads(2),
+generatorBuffer(64),
+finishedRetention(100),
+maxOverallMemory(0),
+memoryPerFrame(16),
+memoryPerProcess(4096),
+pageReplacement("lru"),
+backingStorePath("csopesy-backing-store.bin"),
 running(false) {
 }
 
-void Scheduler::initialize(const std::string& configPath) {
+static void stripQuotes(std::string& value) {
+    if (value.size() >= 2 && value.front() == '"' && value.back() == '"') {
+        value = value.substr(1, value.size() - 2);
+    }
+}
+
+bool Scheduler::initialize(const std::string& configPath) {
     std::ifstream config(configPath);
     if (!config.is_open()) {
         std::cerr << "Failed to open " << configPath << "\n";
-        return;
+        return false;
     }
 
     std::string line;
@@ -43,6 +77,21 @@ void Scheduler::initialize(const std::string& configPath) {
         else if (key == "quantum-cycles") {
             iss >> quantumCycles;
         }
+        else if (key == "quantum-mode") {
+            iss >> quantumMode;
+        }
+        else if (key == "quantum-min") {
+            iss >> minQuantum;
+        }
+        else if (key == "quantum-max") {
+            iss >> maxQuantum;
+        }
+        else if (key == "target-response") {
+            iss >> targetResponse;
+        }
+        else if (key == "quantum-log") {
+            iss >> quantumLogPath;
+        }
         else if (key == "batch-process-freq") {
             iss >> batchFrequency;
         }
@@ -55,274 +104,956 @@ void Scheduler::initialize(const std::string& configPath) {
         else if (key == "delay-per-exec") {
             iss >> delayPerExecution;
         }
+        else if (key == "max-variables") {
+            iss >> maxVariables;
+        }
+        else if (key == "log-capacity") {
+            iss >> logCapacity;
+        }
+        else if (key == "log-persist") {
+            iss >> logPersist;
+        }
+        else if (key == "log-path") {
+            iss >> logPath;
+        }
+        else if (key == "log-flush-ms") {
+            iss >> logFlushMs;
+        }
+        else if (key == "log-fsync-ms") {
+            iss >> logFsyncMs;
+        }
+        else if (key == "ready-queue") {
+            iss >> readyQueueMode;
+        }
+        else if (key == "mlfq-levels") {
+            iss >> mlfqLevels;
+        }
+        else if (key == "mlfq-aging") {
+            iss >> mlfqAging;
+        }
+        else if (key == "program-variants") {
+            iss >> programVariants;
+        }
+        else if (key == "finished-retention") {
+            iss >> finishedRetention;
+        }
+        else if (key == "archive-file") {
+            iss >> archivePath;
+        }
+        else if (key == "simulation") {
+            iss >> simulationMode;
+        }
+        else if (key == "trace-record") {
+            iss >> traceRecordPath;
+        }
+        else if (key == "trace-replay") {
+            iss >> traceReplayPath;
+        }
+        else if (key == "max-overall-mem") {
+            iss >> maxOverallMemory;
+        }
+        else if (key == "mem-per-frame") {
+            iss >> memoryPerFrame;
+        }
+        else if (key == "mem-per-proc") {
+            iss >> memoryPerProcess;
+        }
+        else if (key == "page-replacement") {
+            iss >> pageReplacement;
+        }
+        else if (key == "backing-store") {
+            iss >> backingStorePath;
+        }
+        else if (key == "seed") {
+            iss >> seed;
+        }
+        else if (key == "generator-threads") {
+            iss >> generatorThreads;
+        }
+        else if (key == "generator-buffer") {
+            iss >> generatorBuffer;
+        }
     }
 
-    // Remove quotes from schedulerType so == can compare properly
-    if (!schedulerType.empty() && schedulerType.front() == '"' && schedulerType.back() == '"') {
-        schedulerType = schedulerType.substr(1, schedulerType.size() - 2);
+    // The dispatcher creates a process every batchFrequency ticks, so it must be at least 1
+    if (batchFrequency < 1) {
+        batchFrequency = 1;
     }
 
+    // Remove quotes from string values so == can compare properly
+    stripQuotes(schedulerType);
+    stripQuotes(readyQueueMode);
+    stripQuotes(simulationMode);
+    stripQuotes(quantumMode);
+    stripQuotes(logPersist);
+    stripQuotes(logPath);
+    stripQuotes(quantumLogPath);
+    stripQuotes(archivePath);
+    stripQuotes(traceRecordPath);
+    stripQuotes(traceReplayPath);
+    stripQuotes(pageReplacement);
+    stripQuotes(backingStorePath);
+    // The recorder truncates its file before the reader would open it
+    if (!traceRecordPath.empty() && !traceReplayPath.empty()) {
+        std::error_code ec;
+        if (traceRecordPath == traceReplayPath || std::filesystem::equivalent(traceRecordPath, traceReplayPath, ec)) {
+            std::cerr << "trace-record and trace-replay name the same file (" << traceRecordPath << "); not initialized\n";
+            return false;
+        }
+    }
+    if (simulationMode != "threaded" && simulationMode != "lockstep") {
+        std::cerr << "Unsupported simulation mode: " << simulationMode << ", using threaded\n";
+        simulationMode = "threaded";
+    }
+    if (logPersist != "off" && logPersist != "run" && logPersist != "process") {
+        std::cerr << "Unsupported log persistence: " << logPersist << ", using off\n";
+        logPersist = "off";
+    }
+    if (logPath.empty()) {
+        logPath = logPersist == "process" ? "csopesy-logs" : "csopesy-run-log.txt";
+    }
+    if (quantumMode != "fixed" && quantumMode != "adaptive") {
+        std::cerr << "Unsupported quantum mode: " << quantumMode << ", using fixed\n";
+        quantumMode = "fixed";
+    }
+    if (minQuantum < 1) {
+        minQuantum = 1;
+    }
+    if (maxQuantum < minQuantum) {
+        maxQuantum = minQuantum;
+    }
+    if (mlfqLevels < 1 || mlfqLevels > FeedbackQueue::kMaxLevels) {
+        std::cerr << "mlfq-levels must be 1-" << FeedbackQueue::kMaxLevels << ", using 3\n";
+        mlfqLevels = 3;
+    }
+    if (finishedRetention < 0) {
+        finishedRetention = 0;
+    }
+    if (pageReplacement != "fifo" && pageReplacement != "lru") {
+        std::cerr << "Unsupported page replacement: " << pageReplacement << ", using lru\n";
+        pageReplacement = "lru";
+    }
+    // Every variable is one 2-byte word of the process's memory; the last word
+    // is left for the slot that writes past the symbol table go to
+    if (maxOverallMemory > 0 && memoryPerProcess >= 4) {
+        size_t words = memoryPerProcess / 2;
+        if (maxVariables == 0 || maxVariables > words - 1) {
+            maxVariables = words - 1;
+        }
+    }
+
+    // The policy and the generator are only swapped while no core or dispatcher is using them
+    if (!running) {
+        // Seed 0 picks a fresh random seed; view-config shows it so the run can be reproduced
+        effectiveSeed = seed != 0 ? seed : (static_cast<uint64_t>(std::random_device{}()) << 32) | std::random_device{}();
+
+        ProgramGenerator::Params params;
+        params.minInstructions = minInstructions;
+        params.maxInstructions = maxInstructions;
+        params.maxVariables = maxVariables;
+        params.variants = programVariants;
+        params.seed = effectiveSeed;
+
+        // Cached programs were built for the previous parameters; processes keep theirs alive
+        programCache.clear();
+        generator.reset(params, &programCache);
+        manualPrograms = 0;
+
+        // Cores queue evicted processes on the archive while running
+        if (!archive.open(archivePath)) {
+            std::cerr << "Failed to open archive file " << archivePath << "; finished processes will not be archived\n";
+        }
+
+        // Processes created from here on page their variables through the new
+        // manager; existing ones keep the one they were created with
+        memory.reset();
+        if (maxOverallMemory > 0) {
+            auto replacement = pageReplacement == "fifo" ? MemoryManager::Replacement::FIFO : MemoryManager::Replacement::LRU;
+            memory = std::make_shared<MemoryManager>(maxOverallMemory, memoryPerFrame, replacement, backingStorePath);
+            // One instruction can touch three pages, all of which must fit at once
+            if (memory->stats().totalFrames < 3) {
+                std::cerr << "max-overall-mem holds fewer than 3 frames; memory is not paged\n";
+                memory.reset();
+            }
+            else if (!backingStorePath.empty() && !memory->hasBackingStore()) {
+                std::cerr << "Failed to open backing store " << backingStorePath << "; evicted pages are discarded\n";
+            }
+        }
+
+        // Trace ticks count from here
+        if (!traceRecorder.open(traceRecordPath)) {
+            std::cerr << "Failed to open trace file " << traceRecordPath << " for recording\n";
+        }
+        if (!traceReplay.open(traceReplayPath, maxVariables)) {
+            std::cerr << "Failed to open trace file " << traceReplayPath << " for replay; generating processes instead\n";
+        }
+        recordOrigin = replayOrigin = clock.now();
+        workloadDone = false;
+
+        policy = SchedulingPolicy::create(schedulerType, readyQueueMode, numCores, quantumCycles, mlfqLevels, mlfqAging, &clock);
+        if (!policy) {
+            std::cerr << "Unsupported scheduler: " << schedulerType << ", falling back to fcfs\n";
+            policy = SchedulingPolicy::create("fcfs", readyQueueMode, numCores, quantumCycles);
+        }
+
+        // Host timings would make lockstep runs differ, so only threaded mode measures switch cost
+        bool adaptive = quantumMode == "adaptive" && schedulerType == "rr";
+        if (quantumMode == "adaptive" && !adaptive) {
+            std::cerr << "quantum-mode adaptive only applies to rr; the quantum stays fixed\n";
+        }
+        if (!quantumTuner.configure(adaptive, quantumCycles, minQuantum, maxQuantum, targetResponse,
+                simulationMode == "threaded", quantumLogPath)) {
+            std::cerr << "Failed to open quantum log " << quantumLogPath << "; changes are only shown by report-util\n";
+        }
+        if (adaptive) {
+            policy->setQuantum(quantumTuner.get());
+        }
+
+        // Logs collected in the previous run are written out before the file changes
+        LogWriter::Mode logMode = logPersist == "run" ? LogWriter::Mode::Run
+            : logPersist == "process" ? LogWriter::Mode::PerProcess : LogWriter::Mode::Off;
+        if (!logWriter.open(logMode, logPath, numCores, std::chrono::milliseconds(logFlushMs), std::chrono::milliseconds(logFsyncMs))) {
+            std::cerr << "Failed to open " << logPath << " for process logs; logs are kept in memory only\n";
+        }
+
+        coreProcesses.assign(numCores, nullptr);
+        status.resize(numCores);
+        preemptFlags = std::vector<std::atomic<bool>>(numCores);
+    }
+    else {
+        std::cerr << "Scheduler is running; the new scheduling policy applies after scheduler-stop.\n";
+    }
+
+    return true;
 }
 
 // Starts the scheduler: spawns core worker threads and the dispatcher thread.
+// If the cores are already running (screen -s started them), only process
+// generation is turned on.
 void Scheduler::start(bool withDispatcher) {
+    if (running) {
+        if (withDispatcher) startGenerating();
+        return;
+    }
     running = true;
-    coreAvailable.resize(numCores, true);
+
+    if (simulationMode == "lockstep") {
+        // Before the thread exists, so a seeded run generates from its first tick
+        if (withDispatcher) startGenerating();
+        simulationThread = std::thread(&Scheduler::simulate, this);
+        return;
+    }
 
     for (int i = 0; i < numCores; ++i) {
         cores.emplace_back(&Scheduler::coreWorker, this, i);
     }
 
     if (withDispatcher) {
-        dispatcherThread = std::thread(&Scheduler::dispatcher, this);
+        startGenerating();
     }
 
 }
 
+// Console thread only. Lockstep mode has no dispatcher thread; simulate()
+// picks the flag up on its next tick.
+void Scheduler::startGenerating() {
+    if (generating) return;
 
+    // A replayed trace supplies the programs instead of the generator
+    if (!traceReplay.isOpen()) {
+        generator.start(generatorThreads, static_cast<size_t>(std::max(generatorBuffer, 1)));
+    }
+    generating = true;
+
+    if (simulationMode != "lockstep") {
+        dispatcherThread = std::thread(&Scheduler::dispatcher, this);
+    }
+}
 
 void Scheduler::stop() {
     running = false;
 
-    cv.notify_all();
+    if (policy) {
+        policy->wakeAll();
+    }
+    clock.wakeAll();
+    generator.stop();   // also releases a dispatcher waiting for its next program
 
     // Wait for dispatcher to finish
     if (dispatcherThread.joinable()) {
         dispatcherThread.join();
     }
+    if (simulationThread.joinable()) {
+        simulationThread.join();
+    }
 
     // Wait for core workers to finish
     for (auto& t : cores) {
         if (t.joinable()) t.join();
     }
+    cores.clear();
+    generating = false;
+    traceRecorder.flush();
+    logWriter.flush();
+    quantumTuner.flush();
 
     std::cout << "Scheduler stopped.\n";
 }
 
 
 
-std::vector<Instruction> Scheduler::generateDummyInstructions(int count, int depth) {
-    std::vector<Instruction> instructions;
-	const int maxDepth = 3; // (depth=the number of nested for loops)
-
-    for (int i = 0; i < count; ++i) {
-        int choice = rand() % 6;
-
-        switch (choice) {
-        case 0: // PRINT
-            instructions.emplace_back(InstructionType::PRINT);
-            break;
-        case 1: // DECLARE
-            instructions.emplace_back(InstructionType::DECLARE, std::vector<std::string>{"var" + std::to_string(i), "10"});
-            break;
-        case 2: // ADD
-            instructions.emplace_back(InstructionType::ADD, std::vector<std::string>{"var" + std::to_string(i), "1", "2"});
-            break;
-        case 3: // SUBTRACT
-            instructions.emplace_back(InstructionType::SUBTRACT, std::vector<std::string>{"var" + std::to_string(i), "5", "3"});
-            break;
-        case 4: // SLEEP
-            instructions.emplace_back(InstructionType::SLEEP, std::vector<std::string>{"1"});
-            break;
-        case 5: { // FOR loop
-            if (depth < maxDepth) {
-                int repeats = 2 + rand() % 3;   // repeat 24 times (repeats=the number of times for loop will repeat)
-                int bodySize = 2 + rand() % 3;  // body has 24 instructions (body=the number of instructions in the for loop)
-                auto body = generateDummyInstructions(bodySize, depth + 1);
-                Instruction forIns(InstructionType::FOR);
-                forIns.repeatCount = repeats;
-                forIns.body = body;
-                instructions.push_back(forIns);
-            }
-            else {
-                // depth limit reached, so just do print
-                instructions.emplace_back(InstructionType::PRINT);
-            }
-            break;
-        default:
-            instructions.emplace_back(InstructionType::PRINT);
-            break;
+
+// Generates one process on every batchFrequency tick of the simulated CPU clock
+// and sleeps in between instead of spinning.
+void Scheduler::dispatcher() {
+    uint64_t nextArrival = clock.now();
+    if (!advanceArrival(nextArrival)) return;
+
+    while (running) {
+        uint64_t now = clock.waitUntil(nextArrival, running);
+
+        // Catch up on every arrival that fell due while waiting so the creation
+        // rate stays exactly one process per batchFrequency ticks
+        while (running && nextArrival <= now) {
+            if (!createBatchProcess() || !advanceArrival(nextArrival)) return;
         }
+    }
+}
+
+
+// Moves tick on to the next batch arrival: batchFrequency ticks later, or the
+// next record's tick when replaying a trace. Returns false once the trace is exhausted.
+bool Scheduler::advanceArrival(uint64_t& tick) {
+    if (!traceReplay.isOpen()) {
+        tick += batchFrequency;
+        return true;
+    }
+    const TraceArrival* arrival = traceReplay.peek();
+    if (!arrival) {
+        workloadDone = true;
+        return false;
+    }
+    tick = replayOrigin + arrival->tick;
+    return true;
+}
+
+// Creates and admits the next batch process, generated or replayed. Returns
+// false once the process limit is reached, the trace is exhausted or the
+// generator has been stopped.
+bool Scheduler::createBatchProcess() {
+    if (processLimit > 0 && generatedProcesses >= processLimit) {
+        workloadDone = true;
+        return false;
+    }
+
+    int pid = 0;
+    std::string name;
+    std::shared_ptr<const Program> program;
+    if (traceReplay.isOpen()) {
+        const TraceArrival* arrival = traceReplay.peek();
+        if (!arrival) {
+            workloadDone = true;
+            return false;
         }
+        pid = nextProcessId++;
+        name = arrival->name;
+        program = arrival->program;
+        traceReplay.pop();
+    }
+    else {
+        // Built ahead of time by the generator threads, in seed order
+        program = generator.next();
+        if (!program) return false;
+        pid = nextProcessId++;
+        std::ostringstream formatted;
+        formatted << "Process_" << std::setw(2) << std::setfill('0') << pid;
+        name = formatted.str();
     }
+    ++generatedProcesses;
 
-    return instructions;
+    admit(Process::create(pid, name, std::move(program), logCapacity));
+    return true;
 }
 
+// Blocks until the policy has work for this core; idle periods advance the clock.
+// Host time spent waiting since idleSince is booked as idle time as it passes.
+std::shared_ptr<Process> Scheduler::nextProcess(int coreId, std::chrono::steady_clock::time_point& idleSince) {
+    while (running) {
+        wakeSleepers();
+
+        auto proc = policy->tryPop(coreId);
+        if (proc) return proc;
+
+        // A full idle period without work counts as one idle CPU tick
+        if (!policy->waitForWork(coreId, clock.getIdlePeriod(), running)) {
+            clock.idleTick();
+            status.recordIdleTick(coreId);
+            auto now = std::chrono::steady_clock::now();
+            status.recordIdleTime(coreId, std::chrono::duration_cast<std::chrono::nanoseconds>(now - idleSince).count());
+            idleSince = now;
+        }
+    }
+    return nullptr;
+}
 
-void Scheduler::dispatcher() {
-    int cpuCycles = 0;
+// Moves every process whose SLEEP has elapsed back into the ready queue(s).
+// Called by cores between dispatches; the timer wheel makes this a no-op
+// unless the clock moved and no other core is already doing it.
+void Scheduler::wakeSleepers() {
+    std::vector<std::shared_ptr<Process>> woken;
+    if (sleepingProcesses.expire(clock.now(), woken) == 0) return;
+    for (auto& proc : woken) {
+        proc->markReady(clock.now());
+        requestPreemption(*proc);
+        policy->requeue(std::move(proc), RunResult::SLEEPING, -1);
+    }
+}
+
+// Enqueues a newly created process.
+void Scheduler::admit(std::shared_ptr<Process> proc) {
+    if (memory) {
+        proc->attachMemory(memory);
+    }
+    uint64_t now = clock.now();
+    proc->markArrived(now);
+    if (traceRecorder.isOpen()) {
+        traceRecorder.record(now - recordOrigin, *proc);
+    }
+    processes.insert(proc);
+    status.processCreated(proc);
+    requestPreemption(*proc);
+    policy->admit(std::move(proc));
+}
+
+// Preemptive policies may take a core away from its process when another one becomes ready.
+void Scheduler::requestPreemption(const Process& arriving) {
+    if (!policy->isPreemptive()) return;
+
+    std::lock_guard<std::mutex> lock(tableMutex);
+    // Cores already being preempted are not candidates
+    std::vector<std::shared_ptr<Process>> candidates(coreProcesses);
+    for (int c = 0; c < numCores; ++c) {
+        if (preemptFlags[c].load(std::memory_order_relaxed)) candidates[c] = nullptr;
+    }
+
+    int victim = policy->preemptionVictim(arriving, candidates);
+    if (victim >= 0) {
+        preemptFlags[victim].store(true, std::memory_order_relaxed);
+    }
+}
 
+// Continuously picks processes from the queue and runs them on the assigned core.
+void Scheduler::coreWorker(int coreId) {
+    // Only preemptive policies pay for the per-instruction flag check
+    const std::atomic<bool>* preempt = policy->isPreemptive() ? &preemptFlags[coreId] : nullptr;
+    // Long bursts hand their logs to the writer before the process's log ring wraps
+    LogDrain* drain = logWriter.isOpen() ? &logWriter : nullptr;
+    std::vector<std::shared_ptr<Process>> evicted;  // finished processes leaving the retention window
+    // Utilization counts host time, since instructions and idle periods are not comparable here
+    auto idleSince = std::chrono::steady_clock::now();
 
     while (running) {
-        cpuCycles++;
+        std::shared_ptr<Process> proc = nextProcess(coreId, idleSince);
 
-        if (cpuCycles % batchFrequency == 0) {
-            // Add one process on every batchFrequency tick
-            int pid = nextProcessId++;
-            std::ostringstream name;
-            name << "Process_" << std::setw(2) << std::setfill('0') << pid;
+        if (!running) {
+            // Stopped between dequeue and dispatch: keep the process for the next start
+            if (proc) {
+                proc->markReady(clock.now());
+                policy->requeue(proc, RunResult::STOPPED, coreId);
+            }
+            return;
+        }
 
-            int numInstructions = minInstructions;
-            if (maxInstructions > minInstructions) {
-                numInstructions += rand() % (maxInstructions - minInstructions + 1);
+        if (proc) {
+            // The adaptive quantum weighs host time spent switching against time spent executing
+            bool timed = quantumTuner.measuresOverhead();
+            auto dispatchStart = std::chrono::steady_clock::now();
+            status.recordIdleTime(coreId, std::chrono::duration_cast<std::chrono::nanoseconds>(dispatchStart - idleSince).count());
+            beginBurst(coreId, proc);
+            uint64_t cpuBefore = proc->getCpuTicks();
+            auto runStart = timed ? std::chrono::steady_clock::now() : dispatchStart;
+
+            RunResult result = proc->run(coreId, delayPerExecution, policy->quantumFor(*proc), running, clock, preempt, drain);
+
+            uint64_t cycles = proc->getCpuTicks() - cpuBefore;
+            auto runEnd = timed ? std::chrono::steady_clock::now() : runStart;
+            endBurst(coreId, proc, result, cycles, evicted);
+            idleSince = std::chrono::steady_clock::now();
+            status.recordBusyTime(coreId, std::chrono::duration_cast<std::chrono::nanoseconds>(idleSince - dispatchStart).count());
+            if (timed) {
+                auto switchTime = (runStart - dispatchStart) + (idleSince - runEnd);
+                quantumTuner.recordOverhead(std::chrono::duration_cast<std::chrono::nanoseconds>(switchTime).count(),
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(runEnd - runStart).count(), cycles);
             }
+            wakeSleepers();
+        }
+    }
+}
 
-            auto instructions = generateDummyInstructions(numInstructions);
-            auto process = std::make_shared<Process>(pid, name.str(), instructions);
+// Puts a process on a core: listed as running, timed as dispatched.
+void Scheduler::beginBurst(int coreId, const std::shared_ptr<Process>& proc) {
+    {
+        std::lock_guard<std::mutex> lock(tableMutex);
+        coreProcesses[coreId] = proc;
+        preemptFlags[coreId].store(false, std::memory_order_relaxed);
+    }
+    if (PageTable* pages = proc->getPageTable()) {
+        pages->pin();
+    }
+    status.setCoreBusy(coreId, true);
+    status.recordDispatch(coreId, policy->size());
+    uint64_t now = clock.now();
+    uint64_t waited = proc->markDispatched(now);
+    if (int quantum = quantumTuner.recordDispatch(now, waited)) {
+        policy->setQuantum(quantum);
+    }
+}
 
-            {
-                std::lock_guard<std::mutex> lock(queueMutex);
-                readyQueue.push(process);
+// Takes a process off its core after `cycles` executed instructions and
+// retires, parks or requeues it according to why it stopped. evicted is
+// scratch space reused across calls.
+void Scheduler::endBurst(int coreId, const std::shared_ptr<Process>& proc, RunResult result, uint64_t cycles,
+    std::vector<std::shared_ptr<Process>>& evicted) {
+    bool finished = (result == RunResult::FINISHED);
+    bool switched = !finished && result != RunResult::STOPPED;
+    status.recordBurst(coreId, cycles, switched);
+    if (PageTable* pages = proc->getPageTable()) {
+        pages->unpin();
+        if (finished) proc->releaseMemory();
+    }
+    if (finished) policy->retire(*proc);
+    {
+        std::lock_guard<std::mutex> lock(tableMutex);
+        coreProcesses[coreId] = nullptr;
+
+        if (finished) {
+            proc->markFinished(clock.now());
+
+            // Keep the newest finishedRetention processes whole in the process
+            // table; older ones survive only as status summaries (and in the archive)
+            retainedFinished.push_back(proc);
+            while (retainedFinished.size() > static_cast<size_t>(finishedRetention)) {
+                evicted.push_back(retainedFinished.front());
+                retainedFinished.pop_front();
             }
-            cv.notify_all();
         }
+        else {
+            // Preempted, sleeping or stopped: the process gives up the core
+            // until it is dispatched again
+            if (switched) {
+                proc->recordContextSwitch();
+            }
+            proc->releaseCore();
+        }
+    }
 
+    status.setCoreBusy(coreId, false);
+    // Outside tableMutex: publishing copies the live set
+    if (finished) status.processFinished(*proc);
+    // After markFinished, so the writer can tell a process's last burst
+    logWriter.collect(coreId, proc);
 
+    // The archive's writer thread formats and spills them; only queued here, outside tableMutex
+    for (auto& old : evicted) {
+        processes.erase(*old);
+        if (archive.isOpen()) archive.append(std::move(old));
+    }
+    evicted.clear();
+
+    if (result == RunResult::SLEEPING) {
+        proc->markWaiting();
+        sleepingProcesses.schedule(proc, proc->getWakeTick());
+    }
+    else if (!finished) {
+        proc->markReady(clock.now());
+        policy->requeue(proc, result, coreId);
     }
 }
 
+// Lockstep mode: this one thread stands in for the dispatcher and every core
+// worker. Each clock tick it creates the batch process that is due, wakes
+// sleepers, fills idle cores in core order and then executes exactly one
+// instruction on every busy core, so a given seed and config always produce
+// the same schedule. No thread waits on the wall clock; stretches where every
+// core is idle are skipped in one jump.
+void Scheduler::simulate() {
+    struct CoreState {
+        std::shared_ptr<Process> proc;
+        int quantum = 0;
+        uint64_t cpuBefore = 0;
+        uint64_t dispatchedAt = 0;  // tick the process was put on the core
+    };
+    std::vector<CoreState> coreState(numCores);
+    std::vector<std::shared_ptr<Process>> evicted;
+    LogDrain* drain = logWriter.isOpen() ? &logWriter : nullptr;
+    uint64_t nextArrival = 0;
+    bool generationSeen = false;    // scheduler-start can turn generation on mid-run
+    bool arriving = false;
 
-// Continuously picks processes from the queue and runs them on the assigned core.
-void Scheduler::coreWorker(int coreId) {
     while (running) {
-        std::shared_ptr<Process> proc = nullptr;
-
-        {
-            std::unique_lock<std::mutex> lock(queueMutex);
-            cv.wait(lock, [&] {
-                return (!readyQueue.empty() && coreAvailable[coreId]) || !running;
-                });
-
-
-            if (!running) return;
-
-            // Scheduler selection logic goes here
-            if (!readyQueue.empty() && coreAvailable[coreId]) {
-                if (schedulerType == "fcfs" or schedulerType == "rr") { //Round Robin is just fcfs with quantum cycles*
-                    proc = readyQueue.front();
-                    readyQueue.pop();
-                    cv.notify_all();
-                }
-                else {
-                    std::cerr << "Unsupported scheduler: " << schedulerType << "\n";
-                }
-
-                coreAvailable[coreId] = false;
-                runningProcesses[proc->getName()] = proc;
+        uint64_t now = clock.now();
+        if (tickLimit > 0 && now >= tickLimit) break;
+        if (processLimit > 0 && status.finishedCount() >= static_cast<size_t>(processLimit)) break;
+
+        if (!generationSeen && generating) {
+            generationSeen = true;
+            nextArrival = now;
+            arriving = advanceArrival(nextArrival);
+        }
+        while (arriving && now >= nextArrival) {
+            arriving = createBatchProcess() && advanceArrival(nextArrival);
+        }
+        wakeSleepers();
+
+        bool anyBusy = false;
+        for (int c = 0; c < numCores; ++c) {
+            CoreState& core = coreState[c];
+            if (!core.proc) {
+                core.proc = policy->tryPop(c);
+                if (!core.proc) continue;
+                beginBurst(c, core.proc);
+                core.quantum = policy->quantumFor(*core.proc);
+                core.cpuBefore = core.proc->getCpuTicks();
+                core.dispatchedAt = now;
             }
+            anyBusy = true;
         }
 
-        if (proc) {
-            if (schedulerType == "rr") {
-                proc->run(coreId, delayPerExecution, quantumCycles, running);
+        if (!anyBusy) {
+            // Nothing can run before the next arrival or wake-up
+            uint64_t next = std::min(arriving ? nextArrival : UINT64_MAX, sleepingProcesses.nextWakeTick());
+            if (tickLimit > 0) next = std::min(next, tickLimit);
+            if (next == UINT64_MAX) {
+                // Only a manually created process can arrive; wait for it in real time
+                policy->waitForWork(0, clock.getIdlePeriod(), running);
+                continue;
+            }
+            uint64_t skipped = next > now ? next - now : 1;
+            for (int c = 0; c < numCores; ++c) {
+                status.recordIdleTick(c, skipped);
+                status.recordIdleTime(c, skipped);
             }
-            else {
-                proc->run(coreId, delayPerExecution, 0, running);
+            clock.advance(skipped);
+            continue;
+        }
+
+        // Every core was filled before any instruction ran, so a process taken
+        // off a core below cannot run again until the next tick
+        for (int c = 0; c < numCores; ++c) {
+            CoreState& core = coreState[c];
+            if (!core.proc) {
+                status.recordIdleTick(c);
+                status.recordIdleTime(c, 1);
+                continue;
             }
 
-            {
-                std::lock_guard<std::mutex> lock(queueMutex);
-                finishedProcesses[proc->getName()] = proc;
-                runningProcesses.erase(proc->getName());
-                coreAvailable[coreId] = true;
-                cv.notify_all();
+            uint64_t executed = core.proc->getCpuTicks();
+            RunResult result = core.proc->step(c, now, drain);
+            uint64_t cycles = core.proc->getCpuTicks() - core.cpuBefore;
+            if (result == RunResult::PREEMPTED) {
+                // No instruction ran: its memory is held by other running processes
+                bool stalled = core.proc->getCpuTicks() == executed;
+                bool expired = core.quantum > 0 && cycles >= static_cast<uint64_t>(core.quantum);
+                if (!stalled && !expired && !preemptFlags[c].load(std::memory_order_relaxed)) continue;
             }
+            endBurst(c, core.proc, result, cycles, evicted);
+            // The core was busy for every tick it held the process, this one included
+            status.recordBusyTime(c, now + 1 - core.dispatchedAt);
+            core.proc = nullptr;
         }
+
+        clock.advance();
     }
+
+    // Processes still on a core go back to the ready queue for the next start
+    for (int c = 0; c < numCores; ++c) {
+        CoreState& core = coreState[c];
+        if (core.proc) {
+            endBurst(c, core.proc, RunResult::STOPPED, core.proc->getCpuTicks() - core.cpuBefore, evicted);
+            status.recordBusyTime(c, clock.now() - core.dispatchedAt);
+        }
+    }
+}
+
+// Finished processes per screen -ls page
+static const size_t kFinishedPageSize = 50;
+
+static uint64_t percent(uint64_t part, uint64_t whole) {
+    return whole > 0 ? part * 100 / whole : 0;
 }
 
-void Scheduler::printStatus() {
-    int usedCores = 0;
-    for (bool available : coreAvailable) {
-        if (!available) ++usedCores;
+// Core:N, Sleeping, Ready or Finished, as listed by screen -ls
+std::string Scheduler::describeState(const Process& proc, bool finished) const {
+    switch (finished ? ProcessState::FINISHED : proc.getState()) {
+    case ProcessState::FINISHED:
+        return "Finished";
+    case ProcessState::WAITING:
+        return "Sleeping";
+    case ProcessState::RUNNING: {
+        int core = proc.getAssignedCore();
+        if (core >= 0) return "Core:" + std::to_string(core);
+        return "Ready";
     }
+    default:
+        return "Ready";
+    }
+}
 
-    std::cout << "CPU Utilization: " << (usedCores * 100 / numCores) << "%\n";
-    std::cout << "Cores Used: " << usedCores << "\n";
-    std::cout << "Cores Available: " << (numCores - usedCores) << "\n";
-    std::cout << "________________________________________________________\n\n";
+// Shared by screen -ls and report-util. Works from a status snapshot, so it
+// never blocks the core workers however many processes are listed. Only
+// finished processes [firstFinished, endFinished) are listed.
+void Scheduler::writeStatus(std::ostream& out, const StatusSnapshot& snap, size_t firstFinished, size_t endFinished) const {
+    int usedCores = snap.coresUsed;
+    int totalCores = snap.numCores > 0 ? snap.numCores : numCores;
+
+    // Utilization over time: share of core time spent with a process on the core
+    uint64_t busyTicks = 0, busyTime = 0, idleTime = 0;
+    for (const auto& core : snap.cores) {
+        busyTicks += core.busyTicks;
+        busyTime += core.busyTime;
+        idleTime += core.idleTime;
+    }
 
-    std::cout << "Running processes:\n\n";
-    for (const auto& [name, proc] : runningProcesses) {
-        std::cout << name << " | (" << proc->getTimestamp() << ") | ";
-        std::cout << "Core:" << proc->getAssignedCore() << " | ";
-        std::cout << proc->getCurrentLine() << " / " << proc->getTotalLines() << "\n\n";
+    out << "CPU Utilization: " << percent(busyTime, busyTime + idleTime) << "% ("
+        << busyTicks << " instructions executed)\n";
+    out << "Cores Used: " << usedCores << "\n";
+    out << "Cores Available: " << (totalCores - usedCores) << "\n";
+    out << "________________________________________________________\n\n";
+
+    out << "Running processes:\n\n";
+    for (const auto& proc : snap.running) {
+        out << proc->getName() << " | (" << proc->getTimestamp() << ") | ";
+        out << describeState(*proc, false) << " | ";
+        out << proc->getCurrentLine() << " / " << proc->getTotalLines() << "\n\n";
     }
 
-    std::cout << "Finished processes:\n\n";
-    for (const auto& [name, proc] : finishedProcesses) {
-        std::cout << name << " | (" << proc->getTimestamp() << ") | ";
-        std::cout << "Finished | " << proc->getTotalLines() << "/" << proc->getTotalLines() << "\n\n";
+    out << "Finished processes:\n\n";
+    for (size_t i = firstFinished; i < endFinished; ++i) {
+        const ProcessSummary& proc = status.finishedAt(i);
+        out << proc.name << " | (" << proc.timestamp << ") | ";
+        out << "Finished | " << proc.totalLines << "/" << proc.totalLines << "\n\n";
+    }
+    if (endFinished - firstFinished < snap.listedFinished) {
+        out << "Showing finished " << firstFinished + 1 << "-" << endFinished << " of " << snap.listedFinished
+            << " (screen -ls <page> for older; page 1 is the most recent)\n";
+    }
+    if (snap.finishedCount > snap.listedFinished) {
+        out << snap.finishedCount - snap.listedFinished << " more recent finished processes are not listed: the summary list is full\n";
     }
 
-    std::cout << "________________________________________________________\n";
+    out << "________________________________________________________\n";
 }
 
-void Scheduler::writeStatusToFile() {
-    std::ofstream outFile("csopesy-log.txt");
+// Per-core counters, ready-queue histogram and latency averages for report-util
+void Scheduler::writeMetrics(std::ostream& out, const StatusSnapshot& snap) const {
+    out << "\nPer-core activity:\n\n";
+    out << std::left << std::setw(6) << "Core" << std::right << std::setw(14) << "Busy ticks" << std::setw(14) << "Idle ticks"
+        << std::setw(7) << "Util" << std::setw(12) << "Dispatches" << std::setw(18) << "Context switches" << "\n";
+    std::array<uint64_t, kQueueBuckets> queueLength{};
+    for (size_t c = 0; c < snap.cores.size(); ++c) {
+        const CoreStats& core = snap.cores[c];
+        out << std::left << std::setw(6) << c << std::right << std::setw(14) << core.busyTicks << std::setw(14) << core.idleTicks
+            << std::setw(6) << percent(core.busyTime, core.busyTime + core.idleTime) << "%"
+            << std::setw(12) << core.dispatches << std::setw(18) << core.contextSwitches << "\n";
+        for (size_t b = 0; b < kQueueBuckets; ++b) {
+            queueLength[b] += core.queueLength[b];
+        }
+    }
 
-    if (!outFile.is_open()) {
-        std::cerr << "Error: Unable to open csopesy-log.txt for writing.\n";
-        return;
+    out << "\nReady-queue length at dispatch:\n\n";
+    for (size_t b = 0; b < kQueueBuckets; ++b) {
+        std::string range = std::to_string(StatusBoard::bucketFloor(b));
+        if (b + 1 == kQueueBuckets) {
+            range += "+";
+        }
+        else if (StatusBoard::bucketFloor(b + 1) - 1 > StatusBoard::bucketFloor(b)) {
+            range += "-" + std::to_string(StatusBoard::bucketFloor(b + 1) - 1);
+        }
+        out << std::left << std::setw(10) << range << std::right << std::setw(12) << queueLength[b] << "\n";
     }
 
-    int usedCores = 0;
-    for (bool available : coreAvailable) {
-        if (!available) ++usedCores;
+    size_t finished = snap.finishedCount;
+    out << "\nFinished processes: " << finished << "\n";
+    if (finished > 0) {
+        out << "Average turnaround: " << snap.totalTurnaround / finished << " ticks\n";
+        out << "Average waiting: " << snap.totalWaiting / finished << " ticks\n";
+        out << "Average response: " << snap.totalResponse / finished << " ticks\n";
     }
 
-    outFile << "CPU Utilization: " << (usedCores * 100 / numCores) << "%\n";
-    outFile << "Cores Used: " << usedCores << "\n";
-    outFile << "Cores Available: " << (numCores - usedCores) << "\n";
-    outFile << "________________________________________________________\n\n";
+    if (policy) {
+        policy->writeReport(out);
+    }
+    quantumTuner.writeReport(out);
+
+    if (logWriter.isOpen()) {
+        LogWriterStats logs = logWriter.stats();
+        out << "\nProcess logs: " << logs.lines << " lines (" << logs.bytes << " bytes) written to " << logWriter.getPath()
+            << " in " << logs.batches << " batches, " << logs.syncs << " fsyncs\n";
+        if (logs.lost > 0) {
+            out << "Log entries overwritten before they were collected: " << logs.lost << " (raise log-capacity)\n";
+        }
+        if (logs.writeErrors > 0) {
+            out << "Log files that could not be opened: " << logs.writeErrors << "\n";
+        }
+    }
 
-    outFile << "Running processes:\n\n";
-    for (const auto& [name, proc] : runningProcesses) {
-        outFile << name << " | (" << proc->getTimestamp() << ") | ";
-        outFile << "Core:" << proc->getAssignedCore() << " | ";
-        outFile << proc->getCurrentLine() << " / " << proc->getTotalLines() << "\n\n";
+    if (memory) {
+        out << "\n";
+        writeMemoryStats(out);
     }
+}
 
-    outFile << "Finished processes:\n\n";
-    for (const auto& [name, proc] : finishedProcesses) {
-        outFile << name << " | (" << proc->getTimestamp() << ") | ";
-        outFile << "Finished | " << proc->getTotalLines() << "/" << proc->getTotalLines() << "\n\n";
+// Frame usage and paging counters, for vmstat and report-util
+void Scheduler::writeMemoryStats(std::ostream& out) const {
+    if (!memory) {
+        out << "Memory is not paged (max-overall-mem 0)\n";
+        return;
     }
+    MemoryStats mem = memory->stats();
+    out << "Memory: " << mem.usedFrames * mem.frameBytes << " / " << mem.totalFrames * mem.frameBytes << " bytes used ("
+        << mem.usedFrames << " of " << mem.totalFrames << " frames, " << pageReplacement << ")\n";
+    out << "Page faults: " << mem.pageFaults << "\n";
+    out << "Pages paged in: " << mem.pageIns << "\n";
+    out << "Pages paged out: " << mem.pageOuts << "\n";
+}
+
+void Scheduler::printMemoryStats() {
+    writeMemoryStats(std::cout);
+}
 
-    outFile << "________________________________________________________\n";
+// screen -ls [page]: running processes plus one page of finished ones, most recent first page
+void Scheduler::printStatus(size_t page) {
+    StatusSnapshot snap = status.snapshot();
+    size_t pages = (snap.listedFinished + kFinishedPageSize - 1) / kFinishedPageSize;
+    if (page == 0) page = 1;
+    if (pages > 0 && page > pages) page = pages;
 
+    size_t endFinished = snap.listedFinished > (page - 1) * kFinishedPageSize ? snap.listedFinished - (page - 1) * kFinishedPageSize : 0;
+    size_t firstFinished = endFinished > kFinishedPageSize ? endFinished - kFinishedPageSize : 0;
+    writeStatus(std::cout, snap, firstFinished, endFinished);
+}
+
+void Scheduler::writeStatusToFile() {
+    std::ofstream outFile("csopesy-log.txt");
+
+    if (!outFile.is_open()) {
+        std::cerr << "Error: Unable to open csopesy-log.txt for writing.\n";
+        return;
+    }
+
+    StatusSnapshot snap = status.snapshot();
+    writeStatus(outFile, snap, 0, snap.listedFinished);
+    writeMetrics(outFile, snap);
     outFile.close();
+    quantumTuner.flush();
 
     std::cout << "Report generated at csopesy-log.txt\n";
 }
 
+// process-stats [name]: tick bookkeeping for one process, or for the running
+// processes and the most recent page of finished ones
+void Scheduler::printProcessStats(const std::string& processName) {
+    StatusSnapshot snap = status.snapshot();
+
+    std::cout << std::left << std::setw(16) << "Name" << std::setw(10) << "State" << std::right
+              << std::setw(10) << "Arrival" << std::setw(10) << "First run" << std::setw(10) << "Finish"
+              << std::setw(10) << "Waiting" << std::setw(10) << "CPU" << std::setw(12) << "Turnaround"
+              << std::setw(10) << "Response" << std::setw(10) << "Switches" << "\n";
+
+    size_t shown = 0;
+    auto printRow = [&](const std::string& name, const std::string& state, const ProcessTimes& times, bool finished, int switches) {
+        if (!processName.empty() && name != processName) return;
+        ++shown;
+        auto tick = [](bool valid, uint64_t value) { return valid ? std::to_string(value) : std::string("-"); };
+        std::cout << std::left << std::setw(16) << name << std::setw(10) << state << std::right
+                  << std::setw(10) << times.arrival
+                  << std::setw(10) << tick(times.started, times.firstRun)
+                  << std::setw(10) << tick(finished, times.finish)
+                  << std::setw(10) << times.waiting
+                  << std::setw(10) << times.cpu
+                  << std::setw(12) << tick(finished, times.finish - times.arrival)
+                  << std::setw(10) << tick(times.started, times.firstRun - times.arrival)
+                  << std::setw(10) << switches << "\n";
+    };
+    for (const auto& proc : snap.running) {
+        printRow(proc->getName(), describeState(*proc, false), proc->getTimes(), false, proc->getContextSwitches());
+    }
+
+    // A name lookup searches every finished process; a listing shows the latest page
+    size_t firstFinished = 0;
+    if (processName.empty() && snap.listedFinished > kFinishedPageSize) {
+        firstFinished = snap.listedFinished - kFinishedPageSize;
+    }
+    for (size_t i = firstFinished; i < snap.listedFinished; ++i) {
+        const ProcessSummary& proc = status.finishedAt(i);
+        printRow(proc.name, "Finished", proc.times, true, proc.contextSwitches);
+    }
+
+    if (shown == 0 && !processName.empty()) {
+        std::cout << "Process " << processName << " not found.\n";
+    }
+}
+
 void Scheduler::viewConfig() {
     std::cout << "Current Scheduler Configuration:\n";
     std::cout << "Number of Cores: " << numCores << "\n";
     std::cout << "Scheduler Type: " << schedulerType << "\n";
     std::cout << "Quantum Cycles: " << quantumCycles << "\n";
+    if (quantumTuner.isEnabled()) {
+        std::cout << "Quantum Mode: adaptive (" << minQuantum << "-" << maxQuantum << ", target response " << targetResponse
+                  << " ticks, now " << quantumTuner.get() << ")\n";
+    }
+    else {
+        std::cout << "Quantum Mode: fixed\n";
+    }
     std::cout << "Batch Process Frequency: " << batchFrequency << "\n";
     std::cout << "Min Instructions: " << minInstructions << "\n";
     std::cout << "Max Instructions: " << maxInstructions << "\n";
     std::cout << "Delay Per Execution: " << delayPerExecution << "\n";
+    std::cout << "Max Variables Per Process: " << maxVariables << "\n";
+    std::cout << "Log Capacity Per Process: " << logCapacity << "\n";
+    if (logWriter.isOpen()) {
+        std::cout << "Log Persistence: " << logPersist << " to " << logPath << " (batch every " << logFlushMs << " ms, fsync "
+                  << (logFsyncMs > 0 ? "every " + std::to_string(logFsyncMs) + " ms" : std::string("on scheduler-stop")) << ")\n";
+    }
+    else {
+        std::cout << "Log Persistence: off\n";
+    }
+    std::cout << "Ready Queue: " << readyQueueMode << "\n";
+    if (schedulerType == "mlfq") {
+        std::cout << "MLFQ Levels: " << mlfqLevels << " (aging " << (mlfqAging > 0 ? "every " + std::to_string(mlfqAging) + " ticks" : std::string("off")) << ")\n";
+    }
+    std::cout << "Simulation: " << simulationMode << "\n";
+    std::cout << "Finished Retention: " << finishedRetention << " processes\n";
+    std::cout << "Archive File: " << (archivePath.empty() ? "(none)" : archivePath) << "\n";
+    if (memory) {
+        MemoryStats mem = memory->stats();
+        std::cout << "Memory: " << maxOverallMemory << " bytes in " << mem.totalFrames << " frames of " << mem.frameBytes
+                  << " bytes, " << memoryPerProcess << " bytes per process, " << pageReplacement << " replacement\n";
+        std::cout << "Backing Store: " << (backingStorePath.empty() ? "(none)" : backingStorePath) << "\n";
+    }
+    else {
+        std::cout << "Memory: not paged\n";
+    }
+    std::cout << "Trace Record: " << (traceRecordPath.empty() ? "(none)" : traceRecordPath) << "\n";
+    std::cout << "Trace Replay: " << (traceReplayPath.empty() ? "(none)" : traceReplayPath) << "\n";
+    std::cout << "Seed: " << seed;
+    if (seed == 0) std::cout << " (this run: " << effectiveSeed << ")";
+    std::cout << "\n";
+    std::cout << "Generator Threads: " << generatorThreads << " (buffer " << generatorBuffer << " programs)\n";
+    std::cout << "Program Variants: " << programVariants
+              << (programVariants > 0 ? " (cached: " + std::to_string(programCache.size()) + ")" : std::string(" (not shared)")) << "\n";
+    if (policy) {
+        std::cout << "Active Policy: " << policy->describe() << "\n";
+    }
 }
 
 void Scheduler::createManualProcess(const std::string& processName) {
-    int numInstructions = minInstructions;
-    if (maxInstructions > minInstructions) {
-        numInstructions += rand() % (maxInstructions - minInstructions + 1);
-    }
-
     int pid = nextProcessId++;
-    auto instructions = generateDummyInstructions(numInstructions);
-    auto process = std::make_shared<Process>(pid, processName, instructions);
+    auto program = generator.build(ProgramGenerator::kManualStream, manualPrograms++);
+    auto process = Process::create(pid, processName, std::move(program), logCapacity);
 
-    {
-        std::lock_guard<std::mutex> lock(queueMutex);
-        readyQueue.push(process);
-    }
-    cv.notify_all();
+    admit(process);
 
     std::cout << "Process " << processName << " created and added to the queue.\n";
 
@@ -332,15 +1063,18 @@ void Scheduler::createManualProcess(const std::string& processName) {
     }
 }
 
-std::shared_ptr<Process> Scheduler::findProcessByName(const std::string& processName) {
-    std::lock_guard<std::mutex> lock(queueMutex);
-    auto itRunning = runningProcesses.find(processName);
-    if (itRunning != runningProcesses.end()) {
-        return itRunning->second;
-    }
-    auto itFinished = finishedProcesses.find(processName);
-    if (itFinished != finishedProcesses.end()) {
-        return itFinished->second;
-    }
-    return nullptr;
+void Scheduler::setTickLimit(uint64_t limit) {
+    tickLimit = limit;
+}
+
+void Scheduler::setProcessLimit(int limit) {
+    processLimit = limit;
+}
+
+bool Scheduler::isDrained() const {
+    return workloadDone && status.finishedCount() == static_cast<size_t>(nextProcessId.load() - 1);
+}
+
+size_t Scheduler::getFinishedCount() const {
+    return status.finishedCount();
 }
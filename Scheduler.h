@@ -1,58 +1,159 @@
 #pragma once
 #include "Process.h"
+#include "CpuClock.h"
+#include "SchedulingPolicy.h"
+#include "LogWriter.h"
+#include "ProcessArchive.h"
+#include "ProcessTable.h"
+#include "ProgramCache.h"
+#include "ProgramGenerator.h"
+#include "QuantumTuner.h"
+#include "StatusBoard.h"
+#include "TimerWheel.h"
+#include "WorkloadTrace.h"
 #include <thread>
 #include <vector>
-#include <queue>
-#include <map>
+#include <deque>
 #include <mutex>
 #include <condition_variable>
 #include <string>
 #include <memory>
 #include <atomic>
+#include <chrono>
+#include <ostream>
 
 class Scheduler {
 public:
     Scheduler();
-    void initialize(const std::string& configPath);
+    bool initialize(const std::string& configPath);
     void start(bool withDispatcher=true);           
     void stop();          
     void dispatcher();       
     void coreWorker(int coreId);
-    void printStatus();
+    void printStatus(size_t page = 1);
     void writeStatusToFile();
+    void printProcessStats(const std::string& processName);
+    void printMemoryStats();
     void viewConfig();
     void createManualProcess(const std::string& processName);
     
 
-    std::map<std::string, std::shared_ptr<Process>> runningProcesses;
-    std::map<std::string, std::shared_ptr<Process>> finishedProcesses;
-    std::shared_ptr<Process> findProcessByName(const std::string& processName);
+    // Any process from creation until it leaves finished-process retention;
+    // safe to call from any thread; only waits for an admit or retention erase in the same shard
+    std::shared_ptr<Process> findProcessByName(const std::string& processName) const { return processes.findByName(processName); }
+    std::shared_ptr<Process> findProcessById(int id) const { return processes.findById(id); }
+
+    // Headless runs (csopesy-bench): stop generating after `limit` processes, 0 = unlimited
+    void setProcessLimit(int limit);
+    // Lockstep mode only: stop the simulation at this tick, 0 = never
+    void setTickLimit(uint64_t limit);
+    size_t getFinishedCount() const;
+    // No more batch processes will arrive (limit reached or trace replayed) and every process has finished
+    bool isDrained() const;
+    uint64_t getCurrentTick() const { return clock.now(); }
+    uint64_t getIdleTicks() const { return clock.getIdleTicks(); }
+    StatusSnapshot getStatusSnapshot() const { return status.snapshot(); }
+    // All zero when memory is not paged
+    MemoryStats getMemoryStats() const { return memory ? memory->stats() : MemoryStats(); }
+    int getNumCores() const { return numCores; }
+    const std::string& getSchedulerType() const { return schedulerType; }
+
 
 private:
-    int nextProcessId = 1; 
+    std::atomic<int> nextProcessId{ 1 };   // shared by the dispatcher and manual creation
+    int processLimit = 0;
+    uint64_t tickLimit = 0;
+    std::atomic<bool> workloadDone{ false };
+    std::atomic<bool> generating{ false };  // batch processes are being created; cleared by stop()
+    int generatedProcesses = 0;
 
 
     int numCores;
     std::string schedulerType;
     int quantumCycles;
+    std::string quantumMode;    // "fixed" or "adaptive" (rr only)
+    int minQuantum;             // adaptive bounds, in instructions
+    int maxQuantum;
+    uint64_t targetResponse;    // ready-queue wait per dispatch the adaptive quantum aims for, in ticks
+    std::string quantumLogPath; // every adaptive quantum change, empty = not written
+    QuantumTuner quantumTuner;
     int batchFrequency;
     int minInstructions;
     int maxInstructions;
     int delayPerExecution;
+    size_t maxVariables;    // symbol table capacity per process, 0 = unlimited
+    size_t logCapacity;     // log ring buffer entries kept per process
+    std::string logPersist;     // "off", "run" (one file) or "process" (a file per process)
+    std::string logPath;        // run mode: file, process mode: directory; empty = default name
+    int logFlushMs;             // how often the log writer wakes up to write a batch
+    int logFsyncMs;             // minimum time between fsyncs, 0 = only on scheduler-stop
+    LogWriter logWriter;
+    std::string readyQueueMode;
+    int mlfqLevels;         // priority levels for scheduler "mlfq"
+    uint64_t mlfqAging;     // ticks between mlfq boosts back to level 0, 0 = never
+    int programVariants;    // distinct shared programs per generation parameters, 0 = every process gets its own
+
+    ProgramCache programCache;
+
+    std::string simulationMode; // "threaded" (a thread per core) or "lockstep" (deterministic, one thread)
+    uint64_t seed;              // config value, 0 = random per initialize
+    uint64_t effectiveSeed = 0;
+    int generatorThreads;
+    int generatorBuffer;        // programs built ahead of the dispatcher
+    ProgramGenerator generator;
+    uint64_t manualPrograms = 0;    // index into the manual program stream
+
+    int finishedRetention;      // finished processes kept whole (program and logs) for screen -r
+    std::string archivePath;    // where processes leaving retention are spilled, empty = nowhere
+    std::deque<std::shared_ptr<Process>> retainedFinished;  // oldest first
+    ProcessArchive archive;
+
+    size_t maxOverallMemory;        // bytes of physical memory for variables, 0 = not paged
+    size_t memoryPerFrame;
+    size_t memoryPerProcess;        // caps each process's variables at memoryPerProcess / 2 - 1
+    std::string pageReplacement;    // "fifo" or "lru"
+    std::string backingStorePath;   // evicted pages, empty = discarded
+    std::shared_ptr<MemoryManager> memory;
+
+    std::string traceRecordPath;    // arrivals are written here, empty = not recorded
+    std::string traceReplayPath;    // batch processes come from here instead of the generator
+    TraceWriter traceRecorder;
+    TraceReader traceReplay;        // only read by the dispatcher (or the lockstep thread)
+    uint64_t recordOrigin = 0;      // clock tick that trace tick 0 corresponds to
+    uint64_t replayOrigin = 0;
 
     std::atomic<bool> running;
 
+    CpuClock clock;
+
     std::vector<std::thread> cores;   
     std::thread dispatcherThread;         
+    std::thread simulationThread;   // lockstep mode: replaces the cores and the dispatcher
 
-    std::vector<bool> coreAvailable; 
+    std::unique_ptr<SchedulingPolicy> policy;  // chosen once in initialize()
+    TimerWheel sleepingProcesses;               // processes parked by SLEEP until their wake tick
 
-    std::queue<std::shared_ptr<Process>> readyQueue;   
-    
+    std::vector<std::shared_ptr<Process>> coreProcesses;   // process on each core, guarded by tableMutex
+    std::vector<std::atomic<bool>> preemptFlags;            // set to take a core's process off it
 
-    std::mutex queueMutex;
-    std::condition_variable cv;
+    ProcessTable processes;         // lookups by name and PID for the console
+    std::mutex tableMutex;          // guards retainedFinished and coreProcesses
+    StatusBoard status;             // lock-free view for screen -ls and report-util
 
-    std::vector<Instruction> generateDummyInstructions(int count, int depth=0);
+    bool advanceArrival(uint64_t& tick);
+    bool createBatchProcess();
+    std::shared_ptr<Process> nextProcess(int coreId, std::chrono::steady_clock::time_point& idleSince);
+    void beginBurst(int coreId, const std::shared_ptr<Process>& proc);
+    void endBurst(int coreId, const std::shared_ptr<Process>& proc, RunResult result, uint64_t cycles,
+        std::vector<std::shared_ptr<Process>>& evicted);
+    void simulate();
+    void startGenerating();
+    void wakeSleepers();
+    void admit(std::shared_ptr<Process> proc);
+    void requestPreemption(const Process& arriving);
+    std::string describeState(const Process& proc, bool finished) const;
+    void writeStatus(std::ostream& out, const StatusSnapshot& snap, size_t firstFinished, size_t endFinished) const;
+    void writeMetrics(std::ostream& out, const StatusSnapshot& snap) const;
+    void writeMemoryStats(std::ostream& out) const;
 
 };
@@ -0,0 +1,155 @@
+#include "SchedulingPolicy.h"
+#include <algorithm>
+#include <iomanip>
+
+WorkStealingPolicy::WorkStealingPolicy(std::string name, int numCores, int quantum)
+    : name(std::move(name)), quantum(quantum) {
+    queues.resize(numCores);
+}
+
+void WorkStealingPolicy::requeue(std::shared_ptr<Process> proc, RunResult why, int coreId) {
+    // Preempted work stays on its core for cache locality; woken sleepers are rebalanced
+    if (coreId >= 0 && why != RunResult::SLEEPING) {
+        queues.push(coreId, std::move(proc));
+    }
+    else {
+        queues.pushBalanced(std::move(proc));
+    }
+}
+
+MlfqPolicy::MlfqPolicy(int levelCount, int baseQuantum, uint64_t agingTicks, const CpuClock* clock)
+    : baseQuantum(std::max(baseQuantum, 1)), agingTicks(agingTicks), clock(clock), queue(levelCount) {
+    stats.resize(queue.getLevelCount());
+    nextBoost = now() + agingTicks;
+}
+
+void MlfqPolicy::admit(std::shared_ptr<Process> proc) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        PolicyState& state = proc->getPolicyState();
+        state.level = 0;
+        state.epoch = epoch;
+        push(std::move(proc));
+    }
+    cv.notify_one();
+}
+
+void MlfqPolicy::requeue(std::shared_ptr<Process> proc, RunResult why, int) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        PolicyState& state = proc->getPolicyState();
+        uint64_t used = proc->getCpuTicks() - state.cpuAtDispatch;
+        stats[state.level].cpuTicks += used;
+        state.cpuAtDispatch = proc->getCpuTicks();
+
+        if (state.epoch != epoch) {
+            // Boosted while it was on a core or asleep
+            state.level = 0;
+            state.epoch = epoch;
+        }
+        else if (why == RunResult::PREEMPTED && used >= static_cast<uint64_t>(quantumOf(state.level))) {
+            // Preempted early (srtf-style flag or a memory stall) keeps its level
+            if (state.level + 1 < queue.getLevelCount()) {
+                ++state.level;
+                ++demotions;
+            }
+        }
+        else if (why == RunResult::SLEEPING && state.level > 0) {
+            --state.level;
+            ++promotions;
+        }
+        push(std::move(proc));
+    }
+    cv.notify_one();
+}
+
+// Requires mutex
+void MlfqPolicy::push(std::shared_ptr<Process> proc) {
+    proc->getPolicyState().queuedAt = now();
+    queue.push(std::move(proc));
+    length.store(queue.size(), std::memory_order_relaxed);
+}
+
+std::shared_ptr<Process> MlfqPolicy::tryPop(int) {
+    std::lock_guard<std::mutex> lock(mutex);
+    uint64_t tick = now();
+    if (agingTicks > 0 && clock && tick >= nextBoost) {
+        ++epoch;
+        ++boosts;
+        queue.boostAll(epoch);
+        nextBoost = tick + agingTicks;
+    }
+
+    auto proc = queue.pop();
+    length.store(queue.size(), std::memory_order_relaxed);
+    if (proc) {
+        PolicyState& state = proc->getPolicyState();
+        LevelStats& level = stats[state.level];
+        ++level.dispatches;
+        level.waitTicks += tick - std::min(tick, state.queuedAt);
+        state.cpuAtDispatch = proc->getCpuTicks();
+    }
+    return proc;
+}
+
+bool MlfqPolicy::waitForWork(int, std::chrono::milliseconds timeout, const std::atomic<bool>& running) {
+    std::unique_lock<std::mutex> lock(mutex);
+    return cv.wait_for(lock, timeout, [&] { return !queue.empty() || !running; });
+}
+
+void MlfqPolicy::wakeAll() {
+    std::lock_guard<std::mutex> lock(mutex);
+    cv.notify_all();
+}
+
+void MlfqPolicy::retire(const Process& proc) {
+    std::lock_guard<std::mutex> lock(mutex);
+    const PolicyState& state = proc.getPolicyState();
+    stats[state.level].cpuTicks += proc.getCpuTicks() - state.cpuAtDispatch;
+}
+
+std::string MlfqPolicy::describe() const {
+    std::string text = "mlfq (" + std::to_string(queue.getLevelCount()) + " levels, quantum "
+        + std::to_string(quantumOf(0)) + "-" + std::to_string(quantumOf(queue.getLevelCount() - 1));
+    text += agingTicks > 0 ? ", aging every " + std::to_string(agingTicks) + " ticks)" : ", no aging)";
+    return text;
+}
+
+void MlfqPolicy::writeReport(std::ostream& out) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    out << "\nMLFQ level residency:\n\n";
+    out << std::left << std::setw(7) << "Level" << std::right << std::setw(9) << "Quantum" << std::setw(8) << "Ready"
+        << std::setw(12) << "Dispatches" << std::setw(14) << "CPU ticks" << std::setw(14) << "Queued ticks" << "\n";
+    for (int l = 0; l < queue.getLevelCount(); ++l) {
+        const LevelStats& level = stats[l];
+        out << std::left << std::setw(7) << l << std::right << std::setw(9) << quantumOf(l) << std::setw(8) << queue.sizeOf(l)
+            << std::setw(12) << level.dispatches << std::setw(14) << level.cpuTicks << std::setw(14) << level.waitTicks << "\n";
+    }
+    out << "\nDemotions: " << demotions << ", promotions: " << promotions << ", aging boosts: " << boosts << "\n";
+}
+
+std::unique_ptr<SchedulingPolicy> SchedulingPolicy::create(const std::string& schedulerType,
+    const std::string& readyQueueMode, int numCores, int quantumCycles,
+    int mlfqLevels, uint64_t mlfqAgingTicks, const CpuClock* clock) {
+    bool perCore = (readyQueueMode == "per-core");
+
+    if (schedulerType == "fcfs" || schedulerType == "rr") {
+        int quantum = schedulerType == "rr" ? quantumCycles : 0; // Round Robin is just fcfs with quantum cycles
+        if (perCore) {
+            return std::make_unique<WorkStealingPolicy>(schedulerType, numCores, quantum);
+        }
+        return std::make_unique<GlobalQueuePolicy<FifoQueue>>(schedulerType, quantum, false);
+    }
+    // sjf/srtf order one queue by remaining instructions, so they always use the global queue
+    if (schedulerType == "sjf") {
+        return std::make_unique<GlobalQueuePolicy<ShortestJobQueue>>(schedulerType, 0, false);
+    }
+    if (schedulerType == "srtf") {
+        return std::make_unique<GlobalQueuePolicy<ShortestJobQueue>>(schedulerType, 0, true);
+    }
+    // mlfq orders by level across all cores, so it also uses the global queue
+    if (schedulerType == "mlfq") {
+        return std::make_unique<MlfqPolicy>(mlfqLevels, quantumCycles, mlfqAgingTicks, clock);
+    }
+    return nullptr;
+}
@@ -0,0 +1,241 @@
+#pragma once
+#include "FeedbackQueue.h"
+#include "Process.h"
+#include "ShortestJobQueue.h"
+#include "WorkStealingQueue.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Owns the ready queue(s) and decides which process a core runs next and for
+// how long. The scheduler creates one policy in initialize() from the
+// "scheduler" and "ready-queue" config keys; after that the dispatch path
+// only makes virtual calls and never looks at the policy's name.
+class SchedulingPolicy {
+public:
+    virtual ~SchedulingPolicy() = default;
+
+    // A newly created process
+    virtual void admit(std::shared_ptr<Process> proc) = 0;
+
+    // A process that left a core without finishing (why = PREEMPTED or
+    // STOPPED) or whose SLEEP elapsed (why = SLEEPING, coreId = -1)
+    virtual void requeue(std::shared_ptr<Process> proc, RunResult why, int coreId) = 0;
+
+    // Non-blocking; returns nullptr if there is nothing for this core
+    virtual std::shared_ptr<Process> tryPop(int coreId) = 0;
+
+    // Blocks up to timeout for work for this core. Returns false on timeout.
+    virtual bool waitForWork(int coreId, std::chrono::milliseconds timeout, const std::atomic<bool>& running) = 0;
+
+    virtual void wakeAll() = 0;
+    virtual size_t size() const = 0;
+
+    // Instructions the process may run before being preempted; 0 = until it finishes or sleeps
+    virtual int quantumFor(const Process& proc) const = 0;
+
+    // Adaptive quantum: bursts that start after the call use the new quantum.
+    // Policies without time slices (fcfs, sjf, srtf, mlfq) ignore it.
+    virtual void setQuantum(int /*cycles*/) {}
+
+    // Preemptive policies return the core whose process should make way for
+    // `arriving` (given the process on each core, nullptr if idle), or -1
+    virtual bool isPreemptive() const { return false; }
+    virtual int preemptionVictim(const Process& /*arriving*/, const std::vector<std::shared_ptr<Process>>& /*onCores*/) const {
+        return -1;
+    }
+
+    // A process that finished on a core; it is not requeued
+    virtual void retire(const Process& /*proc*/) {}
+
+    virtual std::string describe() const = 0;
+
+    // Policy-specific statistics for report-util; nothing by default
+    virtual void writeReport(std::ostream& /*out*/) const {}
+
+    // Returns nullptr for an unknown scheduler type. The mlfq arguments and the
+    // clock (used for aging) are ignored by the other policies.
+    static std::unique_ptr<SchedulingPolicy> create(const std::string& schedulerType,
+        const std::string& readyQueueMode, int numCores, int quantumCycles,
+        int mlfqLevels = 3, uint64_t mlfqAgingTicks = 0, const CpuClock* clock = nullptr);
+};
+
+// FIFO container with the same interface as ShortestJobQueue
+class FifoQueue {
+public:
+    void push(std::shared_ptr<Process> proc) { items.push_back(std::move(proc)); }
+    std::shared_ptr<Process> pop() {
+        if (items.empty()) return nullptr;
+        auto proc = std::move(items.front());
+        items.pop_front();
+        return proc;
+    }
+    bool empty() const { return items.empty(); }
+    size_t size() const { return items.size(); }
+
+private:
+    std::deque<std::shared_ptr<Process>> items;
+};
+
+// One ready queue shared by all cores behind a single lock. Queue is the
+// ordering (FifoQueue for fcfs/rr, ShortestJobQueue for sjf/srtf) and is fixed
+// at compile time, so push/pop are direct, inlinable calls.
+template <typename Queue>
+class GlobalQueuePolicy : public SchedulingPolicy {
+public:
+    GlobalQueuePolicy(std::string name, int quantum, bool preemptive)
+        : name(std::move(name)), quantum(quantum), preemptive(preemptive) {
+    }
+
+    void admit(std::shared_ptr<Process> proc) override { push(std::move(proc)); }
+    void requeue(std::shared_ptr<Process> proc, RunResult, int) override { push(std::move(proc)); }
+
+    std::shared_ptr<Process> tryPop(int) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto proc = queue.pop();
+        length.store(queue.size(), std::memory_order_relaxed);
+        return proc;
+    }
+
+    bool waitForWork(int, std::chrono::milliseconds timeout, const std::atomic<bool>& running) override {
+        std::unique_lock<std::mutex> lock(mutex);
+        return cv.wait_for(lock, timeout, [&] { return !queue.empty() || !running; });
+    }
+
+    void wakeAll() override {
+        std::lock_guard<std::mutex> lock(mutex);
+        cv.notify_all();
+    }
+
+    // Lock-free so cores can sample it on every dispatch
+    size_t size() const override { return length.load(std::memory_order_relaxed); }
+
+    int quantumFor(const Process&) const override { return quantum.load(std::memory_order_relaxed); }
+    void setQuantum(int cycles) override {
+        if (quantum.load(std::memory_order_relaxed) > 0) quantum.store(cycles, std::memory_order_relaxed);
+    }
+    bool isPreemptive() const override { return preemptive; }
+
+    int preemptionVictim(const Process& arriving, const std::vector<std::shared_ptr<Process>>& onCores) const override {
+        // srtf: the core running the job with the most remaining work, if that is more than the arrival's
+        int victim = -1;
+        int longest = ShortestJobQueue::remainingOf(arriving);
+        for (size_t c = 0; c < onCores.size(); ++c) {
+            if (!onCores[c]) continue;
+            int remaining = ShortestJobQueue::remainingOf(*onCores[c]);
+            if (remaining > longest) {
+                longest = remaining;
+                victim = static_cast<int>(c);
+            }
+        }
+        return victim;
+    }
+
+    std::string describe() const override { return name + " (global queue)"; }
+
+private:
+    std::string name;
+    std::atomic<int> quantum;   // 0 = run to completion, fixed
+    bool preemptive;
+
+    Queue queue;
+    std::atomic<size_t> length{ 0 };   // mirrors queue.size(), written under mutex
+    mutable std::mutex mutex;
+    std::condition_variable cv;
+
+    void push(std::shared_ptr<Process> proc) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            queue.push(std::move(proc));
+            length.store(queue.size(), std::memory_order_relaxed);
+        }
+        cv.notify_one();
+    }
+};
+
+// fcfs/rr over per-core deques with work stealing (ready-queue "per-core")
+class WorkStealingPolicy : public SchedulingPolicy {
+public:
+    WorkStealingPolicy(std::string name, int numCores, int quantum);
+
+    void admit(std::shared_ptr<Process> proc) override { queues.pushBalanced(std::move(proc)); }
+    void requeue(std::shared_ptr<Process> proc, RunResult why, int coreId) override;
+    std::shared_ptr<Process> tryPop(int coreId) override { return queues.pop(coreId); }
+    bool waitForWork(int coreId, std::chrono::milliseconds timeout, const std::atomic<bool>& running) override {
+        return queues.waitForWork(coreId, timeout, running);
+    }
+    void wakeAll() override { queues.wakeAll(); }
+    size_t size() const override { return queues.size(); }
+    int quantumFor(const Process&) const override { return quantum.load(std::memory_order_relaxed); }
+    void setQuantum(int cycles) override {
+        if (quantum.load(std::memory_order_relaxed) > 0) quantum.store(cycles, std::memory_order_relaxed);
+    }
+    std::string describe() const override { return name + " (per-core queues, work stealing)"; }
+
+private:
+    std::string name;
+    std::atomic<int> quantum;   // 0 = run to completion, fixed
+    WorkStealingQueue queues;
+};
+
+// Multi-level feedback queue (scheduler "mlfq") over one global FeedbackQueue.
+// Level l runs for quantumCycles << l instructions. A process that uses its
+// whole quantum drops a level and one that sleeps rises a level; every
+// agingTicks clock ticks all processes return to level 0 so long-running ones
+// cannot starve. Processes that are on a core or asleep during that boost are
+// caught by an epoch check when they are next requeued.
+class MlfqPolicy : public SchedulingPolicy {
+public:
+    MlfqPolicy(int levelCount, int baseQuantum, uint64_t agingTicks, const CpuClock* clock);
+
+    void admit(std::shared_ptr<Process> proc) override;
+    void requeue(std::shared_ptr<Process> proc, RunResult why, int coreId) override;
+    std::shared_ptr<Process> tryPop(int coreId) override;
+    bool waitForWork(int coreId, std::chrono::milliseconds timeout, const std::atomic<bool>& running) override;
+    void wakeAll() override;
+    size_t size() const override { return length.load(std::memory_order_relaxed); }
+    int quantumFor(const Process& proc) const override { return quantumOf(proc.getPolicyState().level); }
+    void retire(const Process& proc) override;
+    std::string describe() const override;
+    void writeReport(std::ostream& out) const override;
+
+private:
+    // Residency per level, accumulated since initialize
+    struct LevelStats {
+        uint64_t dispatches = 0;
+        uint64_t cpuTicks = 0;      // instructions executed while at this level
+        uint64_t waitTicks = 0;     // ticks spent queued at this level
+    };
+
+    int baseQuantum;
+    uint64_t agingTicks;        // 0 = no aging
+    const CpuClock* clock;
+
+    FeedbackQueue queue;
+    std::vector<LevelStats> stats;
+    uint64_t demotions = 0;
+    uint64_t promotions = 0;
+    uint64_t boosts = 0;
+    uint64_t epoch = 0;         // bumped by every aging boost
+    uint64_t nextBoost;
+
+    std::atomic<size_t> length{ 0 };   // mirrors queue.size(), written under mutex
+    mutable std::mutex mutex;
+    std::condition_variable cv;
+
+    // Doubles per level, computed in 64 bits and saturated so every level up to kMaxLevels - 1 is valid
+    int quantumOf(int level) const {
+        return static_cast<int>(std::min<int64_t>(static_cast<int64_t>(baseQuantum) << level, INT_MAX));
+    }
+    uint64_t now() const { return clock ? clock->now() : 0; }
+    void push(std::shared_ptr<Process> proc);
+};
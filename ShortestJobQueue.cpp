@@ -0,0 +1,16 @@
+#include "ShortestJobQueue.h"
+#include <algorithm>
+
+void ShortestJobQueue::push(std::shared_ptr<Process> proc) {
+    int remaining = remainingOf(*proc);
+    heap.push_back(Entry{ remaining, nextSeq++, std::move(proc) });
+    std::push_heap(heap.begin(), heap.end(), RunsLater());
+}
+
+std::shared_ptr<Process> ShortestJobQueue::pop() {
+    if (heap.empty()) return nullptr;
+    std::pop_heap(heap.begin(), heap.end(), RunsLater());
+    auto proc = std::move(heap.back().proc);
+    heap.pop_back();
+    return proc;
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include "Process.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Ready queue ordered by remaining instruction count (ties broken by arrival
+// order), backing the sjf and srtf schedulers. A process's key only changes
+// while it runs, i.e. while it is outside the heap, so every push uses the
+// current key and no decrease-key or lazy deletion is needed.
+// Not synchronized: the owning GlobalQueuePolicy holds its lock around every call.
+class ShortestJobQueue {
+public:
+    void push(std::shared_ptr<Process> proc);
+    std::shared_ptr<Process> pop();
+
+    bool empty() const { return heap.empty(); }
+    size_t size() const { return heap.size(); }
+
+    static int remainingOf(const Process& proc) {
+        return proc.getTotalLines() - proc.getCurrentLine();
+    }
+
+private:
+    struct Entry {
+        int remaining;
+        uint64_t seq;
+        std::shared_ptr<Process> proc;
+    };
+
+    // std heap functions build a max-heap, so "less" means "runs later"
+    struct RunsLater {
+        bool operator()(const Entry& a, const Entry& b) const {
+            if (a.remaining != b.remaining) return a.remaining > b.remaining;
+            return a.seq > b.seq;
+        }
+    };
+
+    std::vector<Entry> heap;
+    uint64_t nextSeq = 0;
+};
@@ -0,0 +1,96 @@
+#include "StatusBoard.h"
+#include <algorithm>
+
+void StatusBoard::resize(int numCores) {
+    cores = std::vector<CoreSlot>(numCores);
+}
+
+void StatusBoard::recordDispatch(int coreId, size_t readyQueueLength) {
+    CoreSlot& core = cores[coreId];
+    bump(core.dispatches, 1);
+
+    size_t bucket = 0;
+    while (readyQueueLength > 0 && bucket + 1 < kQueueBuckets) {
+        readyQueueLength >>= 1;
+        ++bucket;
+    }
+    bump(core.queueLength[bucket], 1);
+}
+
+void StatusBoard::recordBurst(int coreId, uint64_t ticks, bool contextSwitch) {
+    CoreSlot& core = cores[coreId];
+    bump(core.busyTicks, ticks);
+    if (contextSwitch) bump(core.contextSwitches, 1);
+}
+
+StatusSnapshot StatusBoard::snapshot() const {
+    StatusSnapshot snap;
+    snap.numCores = static_cast<int>(cores.size());
+    snap.cores.resize(cores.size());
+    for (size_t c = 0; c < cores.size(); ++c) {
+        const CoreSlot& slot = cores[c];
+        CoreStats& stats = snap.cores[c];
+        stats.busy = slot.busy.load(std::memory_order_relaxed);
+        stats.busyTicks = slot.busyTicks.load(std::memory_order_relaxed);
+        stats.idleTicks = slot.idleTicks.load(std::memory_order_relaxed);
+        stats.busyTime = slot.busyTime.load(std::memory_order_relaxed);
+        stats.idleTime = slot.idleTime.load(std::memory_order_relaxed);
+        stats.dispatches = slot.dispatches.load(std::memory_order_relaxed);
+        stats.contextSwitches = slot.contextSwitches.load(std::memory_order_relaxed);
+        for (size_t b = 0; b < kQueueBuckets; ++b) {
+            stats.queueLength[b] = slot.queueLength[b].load(std::memory_order_relaxed);
+        }
+        if (stats.busy) ++snap.coresUsed;
+    }
+
+    // One atomic load: a finishing process leaves running and joins the
+    // totals in the same published version
+    std::shared_ptr<const LiveSet> current = std::atomic_load(&live);
+    snap.running = current->running;
+    snap.finishedCount = current->finishedCount;
+    snap.listedFinished = current->listedFinished;
+    snap.totalTurnaround = current->totalTurnaround;
+    snap.totalWaiting = current->totalWaiting;
+    snap.totalResponse = current->totalResponse;
+    return snap;
+}
+
+template <typename Update>
+void StatusBoard::publish(Update update) {
+    std::lock_guard<std::mutex> lock(liveMutex);
+    auto next = std::make_shared<LiveSet>(*std::atomic_load(&live));
+    update(*next);
+    std::atomic_store(&live, std::shared_ptr<const LiveSet>(std::move(next)));
+}
+
+static bool byId(const std::shared_ptr<const Process>& proc, int id) {
+    return proc->getId() < id;
+}
+
+void StatusBoard::processCreated(std::shared_ptr<const Process> proc) {
+    publish([&](LiveSet& set) {
+        auto at = std::lower_bound(set.running.begin(), set.running.end(), proc->getId(), byId);
+        set.running.insert(at, std::move(proc));
+    });
+}
+
+void StatusBoard::processFinished(const Process& proc) {
+    ProcessSummary summary;
+    summary.id = proc.getId();
+    summary.name = proc.getName();
+    summary.timestamp = proc.getTimestamp();
+    summary.totalLines = proc.getTotalLines();
+    summary.contextSwitches = proc.getContextSwitches();
+    summary.times = proc.getTimes();
+
+    publish([&](LiveSet& set) {
+        set.totalTurnaround += summary.times.finish - summary.times.arrival;
+        set.totalWaiting += summary.times.waiting;
+        set.totalResponse += summary.times.firstRun - summary.times.arrival;
+        finished.append(std::move(summary));
+        set.finishedCount = finishedTotal.fetch_add(1, std::memory_order_relaxed) + 1;
+        set.listedFinished = finished.size();
+        auto at = std::lower_bound(set.running.begin(), set.running.end(), proc.getId(), byId);
+        if (at != set.running.end() && (*at)->getId() == proc.getId()) set.running.erase(at);
+    });
+}
@@ -0,0 +1,132 @@
+#pragma once
+#include "AppendOnlyList.h"
+#include "Process.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Ready-queue length histogram buckets: 0, 1, 2-3, 4-7, ..., >= 2^(kQueueBuckets-2)
+constexpr size_t kQueueBuckets = 12;
+
+// Counters accumulated by one core since initialize
+struct CoreStats {
+    bool busy = false;
+    uint64_t busyTicks = 0;         // instructions executed on this core
+    uint64_t idleTicks = 0;         // ticks (lockstep) or idle periods (threaded) spent waiting for work
+    // Time with and without a process on the core, for utilization: ticks in
+    // lockstep mode, host nanoseconds in threaded mode
+    uint64_t busyTime = 0;
+    uint64_t idleTime = 0;
+    uint64_t dispatches = 0;
+    uint64_t contextSwitches = 0;   // bursts that ended without the process finishing
+    std::array<uint64_t, kQueueBuckets> queueLength{};     // ready-queue length seen at each dispatch
+};
+
+// What is kept of a process once it finishes; its program and logs are not
+struct ProcessSummary {
+    int id = 0;
+    std::string name;
+    std::string timestamp;
+    int totalLines = 0;
+    int contextSwitches = 0;
+    ProcessTimes times;
+};
+
+// Point-in-time view used by screen -ls, report-util and process-stats
+struct StatusSnapshot {
+    int numCores = 0;
+    int coresUsed = 0;
+    std::vector<CoreStats> cores;
+    std::vector<std::shared_ptr<const Process>> running;    // not finished yet, in creation order
+    size_t finishedCount = 0;           // every process that has finished
+    size_t listedFinished = 0;          // StatusBoard::finishedAt(i) is valid for i below this
+
+    // Sums over every finished process, for averages
+    uint64_t totalTurnaround = 0;
+    uint64_t totalWaiting = 0;
+    uint64_t totalResponse = 0;
+};
+
+// Process and core status published by the scheduler for the console. Core
+// workers only touch their own core's slot, so dispatch never shares a lock
+// with the console. The set of live processes changes only when a process is
+// created or finishes: the writer copies the current version, updates it and
+// publishes it with an atomic pointer swap, so snapshot() never takes a lock
+// that a core can wait on. Finished processes are kept as compact summaries
+// in a grow-only list that is read without locking, so listing them costs the
+// workers nothing.
+class StatusBoard {
+public:
+    // Only while no core worker is running; also resets the core counters
+    void resize(int numCores);
+
+    // Core counters; each is only called by the core that owns coreId
+    void setCoreBusy(int coreId, bool busy) {
+        cores[coreId].busy.store(busy, std::memory_order_relaxed);
+    }
+    void recordDispatch(int coreId, size_t readyQueueLength);
+    void recordBurst(int coreId, uint64_t ticks, bool contextSwitch);
+    void recordIdleTick(int coreId, uint64_t ticks = 1) { bump(cores[coreId].idleTicks, ticks); }
+    void recordBusyTime(int coreId, uint64_t time) { bump(cores[coreId].busyTime, time); }
+    void recordIdleTime(int coreId, uint64_t time) { bump(cores[coreId].idleTime, time); }
+
+    void processCreated(std::shared_ptr<const Process> proc);
+    void processFinished(const Process& proc);
+
+    size_t finishedCount() const { return finishedTotal.load(std::memory_order_relaxed); }
+
+    StatusSnapshot snapshot() const;
+
+    // Only valid for i below the listedFinished of an earlier snapshot
+    const ProcessSummary& finishedAt(size_t i) const { return finished[i]; }
+
+    // Lower bound of a queue-length bucket, for printing
+    static size_t bucketFloor(size_t bucket) { return bucket == 0 ? 0 : size_t(1) << (bucket - 1); }
+
+private:
+    // One cache line per core so workers never contend on each other's counters
+    struct alignas(64) CoreSlot {
+        std::atomic<bool> busy{ false };
+        std::atomic<uint64_t> busyTicks{ 0 };
+        std::atomic<uint64_t> idleTicks{ 0 };
+        std::atomic<uint64_t> busyTime{ 0 };
+        std::atomic<uint64_t> idleTime{ 0 };
+        std::atomic<uint64_t> dispatches{ 0 };
+        std::atomic<uint64_t> contextSwitches{ 0 };
+        std::array<std::atomic<uint64_t>, kQueueBuckets> queueLength{};
+    };
+
+    // Single-writer increment: a plain load/store avoids a locked read-modify-write
+    static void bump(std::atomic<uint64_t>& counter, uint64_t n) {
+        counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    std::vector<CoreSlot> cores;
+
+    // One immutable version of the live set and the finished totals; replaced
+    // as a whole so a reader always sees a consistent cut
+    struct LiveSet {
+        std::vector<std::shared_ptr<const Process>> running;    // by id, i.e. creation order
+        size_t finishedCount = 0;
+        size_t listedFinished = 0;
+        uint64_t totalTurnaround = 0;
+        uint64_t totalWaiting = 0;
+        uint64_t totalResponse = 0;
+    };
+
+    // Copies the current version, applies update and publishes the result
+    template <typename Update>
+    void publish(Update update);
+
+    std::mutex liveMutex;           // serializes writers only; readers load `live` atomically
+    std::shared_ptr<const LiveSet> live = std::make_shared<const LiveSet>();
+    std::atomic<size_t> finishedTotal{ 0 };
+
+    // Once the list is full, later summaries are not kept; the totals above
+    // still count them and listings report how many are missing
+    AppendOnlyList<ProcessSummary> finished;
+};
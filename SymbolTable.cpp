@@ -0,0 +1,59 @@
+#include "SymbolTable.h"
+#include <algorithm>
+#include <functional>
+
+SymbolTable::SymbolTable(size_t capacity)
+    : capacity(capacity == 0 || capacity >= kNoSlot ? kNoSlot - 1 : capacity) {
+}
+
+// A flat index costs one allocation per table instead of one node per name,
+// and small tables are sized for their capacity up front so they never grow
+uint16_t SymbolTable::resolve(const std::string& name) {
+    if (index.empty()) {
+        size_t expected = std::min<size_t>(capacity, 64);
+        names.reserve(expected);
+        size_t buckets = 16;
+        while (buckets < expected * 2) buckets *= 2;
+        index.assign(buckets, kNoSlot);
+    }
+
+    size_t bucket = findBucket(name);
+    if (index[bucket] != kNoSlot) return index[bucket];
+    if (names.size() >= capacity) return kNoSlot;
+
+    uint16_t slot = static_cast<uint16_t>(names.size());
+    names.push_back(name);
+    index[bucket] = slot;
+    if (names.size() * 2 > index.size()) {
+        rebuildIndex(index.size() * 2);
+    }
+    return slot;
+}
+
+size_t SymbolTable::findBucket(const std::string& name) const {
+    size_t mask = index.size() - 1;
+    size_t bucket = std::hash<std::string>{}(name) & mask;
+    while (index[bucket] != kNoSlot && names[index[bucket]] != name) {
+        bucket = (bucket + 1) & mask;
+    }
+    return bucket;
+}
+
+void SymbolTable::rebuildIndex(size_t buckets) {
+    index.assign(buckets, kNoSlot);
+    for (size_t slot = 0; slot < names.size(); ++slot) {
+        index[findBucket(names[slot])] = static_cast<uint16_t>(slot);
+    }
+}
+
+void SymbolTable::seal() {
+    std::vector<uint16_t>().swap(index);
+    if (names.capacity() > names.size() * 2) {
+        names.shrink_to_fit();
+    }
+}
+
+const std::string& SymbolTable::nameOf(uint16_t slot) const {
+    static const std::string unmapped = "(symbol table full)";
+    return slot < names.size() ? names[slot] : unmapped;
+}
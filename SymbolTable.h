@@ -0,0 +1,31 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Maps a process's variable names to dense register slots. Slots are assigned
+// in order of first use when the program is compiled, up to a fixed capacity;
+// names past the capacity resolve to kNoSlot (writes are dropped, reads give 0).
+class SymbolTable {
+public:
+    static constexpr uint16_t kNoSlot = UINT16_MAX;
+
+    explicit SymbolTable(size_t capacity = 0);  // 0 = unlimited (up to kNoSlot - 1)
+
+    uint16_t resolve(const std::string& name);
+
+    // Drops the name index once compilation is done; nameOf() keeps working
+    void seal();
+
+    const std::string& nameOf(uint16_t slot) const;
+    size_t size() const { return names.size(); }
+    size_t getCapacity() const { return capacity; }
+
+private:
+    size_t capacity;
+    std::vector<std::string> names;
+    std::vector<uint16_t> index;    // open-addressing name -> slot table (kNoSlot = empty), size is a power of two
+
+    size_t findBucket(const std::string& name) const;
+    void rebuildIndex(size_t buckets);
+};
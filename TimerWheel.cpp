@@ -0,0 +1,70 @@
+#include "TimerWheel.h"
+#include <algorithm>
+
+TimerWheel::TimerWheel(size_t slotCount) {
+    size_t size = 1;
+    while (size < slotCount) size <<= 1;
+    slots.resize(size);
+    mask = size - 1;
+}
+
+void TimerWheel::schedule(std::shared_ptr<Process> proc, uint64_t wakeTick) {
+    std::lock_guard<std::mutex> lock(mutex);
+    // A timer that is already due goes into the next slot to be expired
+    uint64_t slotTick = wakeTick > currentTick ? wakeTick : currentTick + 1;
+    slots[slotTick & mask].push_back(Timer{ wakeTick, std::move(proc) });
+    count.fetch_add(1, std::memory_order_relaxed);
+}
+
+size_t TimerWheel::expire(uint64_t now, std::vector<std::shared_ptr<Process>>& out) {
+    if (now <= processedTick.load(std::memory_order_relaxed)) return 0;
+
+    std::unique_lock<std::mutex> lock(mutex, std::try_to_lock);
+    if (!lock.owns_lock() || now <= currentTick) return 0;
+
+    size_t before = out.size();
+    if (count.load(std::memory_order_relaxed) > 0) {
+        if (now - currentTick >= slots.size()) {
+            // A full rotation or more elapsed: every slot may hold due timers
+            for (auto& slot : slots) {
+                expireSlot(slot, now, out);
+            }
+        }
+        else {
+            for (uint64_t t = currentTick + 1; t <= now; ++t) {
+                expireSlot(slots[t & mask], now, out);
+            }
+        }
+    }
+
+    currentTick = now;
+    processedTick.store(now, std::memory_order_relaxed);
+    count.fetch_sub(out.size() - before, std::memory_order_relaxed);
+    return out.size() - before;
+}
+
+uint64_t TimerWheel::nextWakeTick() {
+    std::lock_guard<std::mutex> lock(mutex);
+    uint64_t earliest = UINT64_MAX;
+    if (count.load(std::memory_order_relaxed) == 0) return earliest;
+    for (const auto& slot : slots) {
+        for (const auto& timer : slot) {
+            earliest = std::min(earliest, timer.wakeTick);
+        }
+    }
+    return earliest;
+}
+
+void TimerWheel::expireSlot(std::vector<Timer>& slot, uint64_t now, std::vector<std::shared_ptr<Process>>& out) {
+    // Timers more than one rotation away stay in the slot for a later pass
+    size_t kept = 0;
+    for (size_t i = 0; i < slot.size(); ++i) {
+        if (slot[i].wakeTick <= now) {
+            out.push_back(std::move(slot[i].proc));
+        }
+        else {
+            slot[kept++] = std::move(slot[i]);
+        }
+    }
+    slot.resize(kept);
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include "Process.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Hashed timer wheel holding sleeping processes until their wake tick. Each
+// slot covers the ticks congruent to its index, so expiring N elapsed ticks
+// only visits min(N, slots) buckets regardless of how many processes sleep.
+class TimerWheel {
+public:
+    explicit TimerWheel(size_t slotCount = 256);   // rounded up to a power of two
+
+    void schedule(std::shared_ptr<Process> proc, uint64_t wakeTick);
+
+    // Moves every process whose wake tick is <= now into out and returns how
+    // many were moved. Never blocks: if another core is already expiring
+    // timers, or no tick has passed since the last call, it returns 0.
+    size_t expire(uint64_t now, std::vector<std::shared_ptr<Process>>& out);
+
+    size_t size() const { return count.load(std::memory_order_relaxed); }
+
+    // Earliest wake tick of any sleeping process, UINT64_MAX if none. Visits
+    // every slot, so it is meant for idle stretches, not the dispatch path.
+    uint64_t nextWakeTick();
+
+private:
+    struct Timer {
+        uint64_t wakeTick;
+        std::shared_ptr<Process> proc;
+    };
+
+    std::vector<std::vector<Timer>> slots;
+    size_t mask;
+
+    std::mutex mutex;
+    uint64_t currentTick = 0;                   // every slot up to this tick has been expired
+    std::atomic<uint64_t> processedTick{ 0 };   // lock-free copy of currentTick for the fast path
+    std::atomic<size_t> count{ 0 };
+
+    void expireSlot(std::vector<Timer>& slot, uint64_t now, std::vector<std::shared_ptr<Process>>& out);
+};
@@ -0,0 +1,102 @@
+#include "WorkStealingQueue.h"
+
+void WorkStealingQueue::resize(int numCores) {
+    queues.clear();
+    for (int i = 0; i < numCores; ++i) {
+        queues.push_back(std::make_unique<LocalQueue>());
+    }
+}
+
+void WorkStealingQueue::push(int coreId, std::shared_ptr<Process> proc) {
+    LocalQueue& q = *queues[coreId];
+    {
+        std::lock_guard<std::mutex> lock(q.mutex);
+        q.items.push_back(std::move(proc));
+        q.length.store(q.items.size(), std::memory_order_relaxed);
+    }
+    q.cv.notify_one();
+}
+
+void WorkStealingQueue::pushBalanced(std::shared_ptr<Process> proc) {
+    // Start the scan at a rotating offset so ties do not always land on core 0
+    int n = getNumCores();
+    int start = static_cast<int>(cursor.fetch_add(1, std::memory_order_relaxed) % n);
+    int target = start;
+    size_t bestLoad = SIZE_MAX;
+
+    for (int i = 0; i < n; ++i) {
+        int c = (start + i) % n;
+        const LocalQueue& q = *queues[c];
+        // A busy core counts as one extra queued process
+        size_t load = q.length.load(std::memory_order_relaxed) + (q.idle.load(std::memory_order_relaxed) ? 0 : 1);
+        if (load < bestLoad) {
+            bestLoad = load;
+            target = c;
+            if (load == 0) break;
+        }
+    }
+
+    push(target, std::move(proc));
+}
+
+std::shared_ptr<Process> WorkStealingQueue::pop(int coreId) {
+    LocalQueue& q = *queues[coreId];
+    if (q.length.load(std::memory_order_relaxed) > 0) {
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (!q.items.empty()) {
+            auto proc = std::move(q.items.front());
+            q.items.pop_front();
+            q.length.store(q.items.size(), std::memory_order_relaxed);
+            return proc;
+        }
+    }
+    return steal(coreId);
+}
+
+std::shared_ptr<Process> WorkStealingQueue::steal(int thiefId) {
+    // Pick the busiest peer from the lock-free length hints, then take from the
+    // tail of its deque so the owner keeps working on the head without conflict
+    int victim = -1;
+    size_t mostWork = 0;
+    for (int c = 0; c < getNumCores(); ++c) {
+        if (c == thiefId) continue;
+        size_t load = queues[c]->length.load(std::memory_order_relaxed);
+        if (load > mostWork) {
+            mostWork = load;
+            victim = c;
+        }
+    }
+    if (victim < 0) return nullptr;
+
+    LocalQueue& q = *queues[victim];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    if (q.items.empty()) return nullptr;
+    auto proc = std::move(q.items.back());
+    q.items.pop_back();
+    q.length.store(q.items.size(), std::memory_order_relaxed);
+    return proc;
+}
+
+bool WorkStealingQueue::waitForWork(int coreId, std::chrono::milliseconds timeout, const std::atomic<bool>& running) {
+    LocalQueue& q = *queues[coreId];
+    std::unique_lock<std::mutex> lock(q.mutex);
+    q.idle.store(true, std::memory_order_relaxed);
+    bool woken = q.cv.wait_for(lock, timeout, [&] { return !q.items.empty() || !running; });
+    q.idle.store(false, std::memory_order_relaxed);
+    return woken;
+}
+
+void WorkStealingQueue::wakeAll() {
+    for (auto& q : queues) {
+        std::lock_guard<std::mutex> lock(q->mutex);
+        q->cv.notify_all();
+    }
+}
+
+size_t WorkStealingQueue::size() const {
+    size_t total = 0;
+    for (const auto& q : queues) {
+        total += q->length.load(std::memory_order_relaxed);
+    }
+    return total;
+}
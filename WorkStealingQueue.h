@@ -0,0 +1,49 @@
+#pragma once
+#include "Process.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Per-core ready queues with work stealing. Each core owns a local deque with
+// its own lock and condition variable, so pushes wake exactly one core and
+// cores only touch a peer's lock when they run out of local work.
+class WorkStealingQueue {
+public:
+    void resize(int numCores);
+    int getNumCores() const { return static_cast<int>(queues.size()); }
+
+    // Push to the tail of a specific core's deque (used to requeue preempted work)
+    void push(int coreId, std::shared_ptr<Process> proc);
+
+    // Push a new arrival to the least loaded core, preferring idle ones
+    void pushBalanced(std::shared_ptr<Process> proc);
+
+    // Pops from the head of the local deque, or steals from the tail of the
+    // busiest peer when the local deque is empty. Returns nullptr if no work.
+    std::shared_ptr<Process> pop(int coreId);
+
+    // Blocks on the core's own condition variable. Returns false on timeout.
+    bool waitForWork(int coreId, std::chrono::milliseconds timeout, const std::atomic<bool>& running);
+
+    void wakeAll();
+    size_t size() const;
+
+private:
+    struct LocalQueue {
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::deque<std::shared_ptr<Process>> items;
+        std::atomic<size_t> length{ 0 };    // mirrors items.size() for lock-free load checks
+        std::atomic<bool> idle{ false };
+    };
+
+    std::vector<std::unique_ptr<LocalQueue>> queues;
+    std::atomic<unsigned> cursor{ 0 };
+
+    std::shared_ptr<Process> steal(int thiefId);
+};
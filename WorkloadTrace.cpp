@@ -0,0 +1,330 @@
+#include "WorkloadTrace.h"
+#include <algorithm>
+#include <cctype>
+#include <iostream>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+// Whitespace-separated tokens of one trace line
+class Tokenizer {
+public:
+    explicit Tokenizer(std::string_view text) : text(text) {}
+
+    bool next(std::string_view& token) {
+        while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) ++pos;
+        if (pos >= text.size()) return false;
+        size_t start = pos;
+        while (pos < text.size() && !std::isspace(static_cast<unsigned char>(text[pos]))) ++pos;
+        token = text.substr(start, pos - start);
+        return true;
+    }
+
+private:
+    std::string_view text;
+    size_t pos = 0;
+};
+
+bool parseNumber(std::string_view token, uint64_t& value) {
+    if (token.empty()) return false;
+    value = 0;
+    for (char c : token) {
+        if (!std::isdigit(static_cast<unsigned char>(c))) return false;
+        value = value * 10 + static_cast<uint64_t>(c - '0');
+    }
+    return true;
+}
+
+// Process names come from screen -s and may contain spaces: whitespace and
+// '%' are written as %XX so the name stays one token
+void appendName(std::string_view name, std::string& out) {
+    static const char hex[] = "0123456789ABCDEF";
+    for (char c : name) {
+        unsigned char u = static_cast<unsigned char>(c);
+        if (std::isspace(u) || c == '%') {
+            out += '%';
+            out += hex[u >> 4];
+            out += hex[u & 0xF];
+        }
+        else {
+            out += c;
+        }
+    }
+}
+
+bool decodeName(std::string_view token, std::string& name) {
+    name.clear();
+    for (size_t i = 0; i < token.size(); ++i) {
+        if (token[i] != '%') {
+            name += token[i];
+            continue;
+        }
+        if (i + 2 >= token.size() || !std::isxdigit(static_cast<unsigned char>(token[i + 1]))
+            || !std::isxdigit(static_cast<unsigned char>(token[i + 2]))) {
+            return false;
+        }
+        name += static_cast<char>(std::stoi(std::string(token.substr(i + 1, 2)), nullptr, 16));
+        i += 2;
+    }
+    return true;
+}
+
+// Reads `count` operand tokens into args
+bool parseArgs(Tokenizer& tokens, size_t count, std::vector<std::string>& args) {
+    std::string_view token;
+    for (size_t i = 0; i < count; ++i) {
+        if (!tokens.next(token)) return false;
+        args.emplace_back(token);
+    }
+    return true;
+}
+
+// Parses instructions up to the end of the line, or up to the "]" closing a FOR body when nested
+bool parseBlock(Tokenizer& tokens, std::vector<Instruction>& out, bool nested, std::string& error) {
+    std::string_view token;
+    while (tokens.next(token)) {
+        if (token == "]") {
+            if (nested) return true;
+            error = "unmatched ]";
+            return false;
+        }
+
+        std::vector<std::string> args;
+        bool ok = true;
+        if (token == "PRINT") {
+            out.emplace_back(InstructionType::PRINT);
+        }
+        else if (token == "DECLARE") {
+            ok = parseArgs(tokens, 2, args);
+            out.emplace_back(InstructionType::DECLARE, args);
+        }
+        else if (token == "ADD") {
+            ok = parseArgs(tokens, 3, args);
+            out.emplace_back(InstructionType::ADD, args);
+        }
+        else if (token == "SUBTRACT") {
+            ok = parseArgs(tokens, 3, args);
+            out.emplace_back(InstructionType::SUBTRACT, args);
+        }
+        else if (token == "SLEEP") {
+            ok = parseArgs(tokens, 1, args);
+            out.emplace_back(InstructionType::SLEEP, args);
+        }
+        else if (token == "FOR") {
+            uint64_t repeats = 0;
+            std::string_view open;
+            if (!tokens.next(token) || !parseNumber(token, repeats) || !tokens.next(open) || open != "[") {
+                error = "expected FOR <count> [";
+                return false;
+            }
+            out.emplace_back(InstructionType::FOR);
+            out.back().repeatCount = static_cast<int>(std::min<uint64_t>(repeats, UINT16_MAX));
+            if (!parseBlock(tokens, out.back().body, true, error)) return false;
+        }
+        else {
+            error = "unknown instruction " + std::string(token);
+            return false;
+        }
+
+        if (!ok) {
+            error = "missing operands for " + std::string(token);
+            return false;
+        }
+    }
+
+    if (nested) {
+        error = "FOR body is not closed with ]";
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+bool TraceWriter::open(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (file.is_open()) file.close();
+    programIds.clear();
+    if (path.empty()) return true;
+
+    file.open(path, std::ios::trunc);
+    if (!file.is_open()) return false;
+    file << "# csopesy workload trace: <tick> <name> <program> | program <id> <program>\n";
+    return true;
+}
+
+void TraceWriter::close() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (file.is_open()) file.close();
+    programIds.clear();
+}
+
+void TraceWriter::flush() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (file.is_open()) file.flush();
+}
+
+void TraceWriter::record(uint64_t tick, const Process& proc) {
+    const auto& program = proc.getProgram();
+    std::string text = std::to_string(tick) + " ";
+    appendName(proc.getName(), text);
+    text += ' ';
+
+    // A program only this process holds is written inline, formatted outside the lock
+    if (program.use_count() <= 1) {
+        formatProgram(*program, text);
+        text += '\n';
+        std::lock_guard<std::mutex> lock(mutex);
+        if (file.is_open()) file << text;
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!file.is_open()) return;
+    auto it = programIds.find(program);
+    if (it == programIds.end()) {
+        it = programIds.emplace(program, programIds.size()).first;
+        std::string definition = "program " + std::to_string(it->second) + " ";
+        formatProgram(*program, definition);
+        file << definition << '\n';
+    }
+    file << text << '@' << it->second << '\n';
+}
+
+void TraceWriter::formatProgram(const Program& program, std::string& out) {
+    // Writes to variables past the symbol table went to the sink slot; any name
+    // that does not fit the table when recompiled lands there again
+    auto variable = [&](uint16_t slot) -> const std::string& {
+        static const std::string overflow = "_";
+        return slot < program.symbols.size() ? program.symbols.nameOf(slot) : overflow;
+    };
+    auto operand = [&](uint16_t value, bool isRegister) {
+        out += ' ';
+        if (isRegister) out += variable(value);
+        else out += std::to_string(value);
+    };
+
+    bool first = true;
+    for (const Op& op : program.code) {
+        if (!first) out += ' ';
+        first = false;
+
+        bool lhsReg = (op.flags & kLhsIsRegister) != 0;
+        bool rhsReg = (op.flags & kRhsIsRegister) != 0;
+        switch (op.code) {
+        case OpCode::PRINT:
+            out += "PRINT";
+            break;
+        case OpCode::DECLARE:
+            out += "DECLARE ";
+            out += variable(op.dst);
+            operand(op.lhs, lhsReg);
+            break;
+        case OpCode::ADD:
+        case OpCode::SUBTRACT:
+            out += op.code == OpCode::ADD ? "ADD " : "SUBTRACT ";
+            out += variable(op.dst);
+            operand(op.lhs, lhsReg);
+            operand(op.rhs, rhsReg);
+            break;
+        case OpCode::SLEEP:
+            out += "SLEEP";
+            operand(op.lhs, lhsReg);
+            break;
+        case OpCode::LOOP_BEGIN:
+            out += "FOR " + std::to_string(op.lhs) + " [";
+            break;
+        case OpCode::LOOP_END:
+            out += ']';
+            break;
+        }
+    }
+}
+
+bool TraceReader::open(const std::string& newPath, size_t newMaxVariables) {
+    close();
+    path = newPath;
+    maxVariables = newMaxVariables;
+    if (path.empty()) return true;
+
+    file.open(path);
+    return file.is_open();
+}
+
+void TraceReader::close() {
+    if (file.is_open()) file.close();
+    lineNumber = 0;
+    lastTick = 0;
+    hasPending = false;
+    pending = TraceArrival();
+    programs.clear();
+}
+
+const TraceArrival* TraceReader::peek() {
+    while (!hasPending && file.is_open() && std::getline(file, line)) {
+        ++lineNumber;
+        hasPending = parseLine();
+    }
+    return hasPending ? &pending : nullptr;
+}
+
+// Parses the current line. Returns true if it was an arrival (now in pending);
+// definitions, comments and malformed lines return false.
+bool TraceReader::parseLine() {
+    Tokenizer tokens(line);
+    std::string_view token;
+    if (!tokens.next(token) || token[0] == '#') return false;
+
+    std::string error;
+    std::vector<Instruction> instructions;
+
+    if (token == "program") {
+        uint64_t id = 0;
+        if (!tokens.next(token) || !parseNumber(token, id)) {
+            error = "expected program <id>";
+        }
+        else if (parseBlock(tokens, instructions, false, error)) {
+            programs[id] = std::make_shared<const Program>(Program::compile(instructions, maxVariables));
+            return false;
+        }
+    }
+    else {
+        uint64_t tick = 0;
+        std::string_view name;
+        if (!parseNumber(token, tick) || !tokens.next(name)) {
+            error = "expected <tick> <name>";
+        }
+        else {
+            // Arrivals are replayed in file order, so a tick earlier than the last one arrives with it
+            pending.tick = std::max(tick, lastTick);
+
+            Tokenizer rest = tokens;
+            std::string_view ref;
+            if (!decodeName(name, pending.name)) {
+                error = "bad % escape in name " + std::string(name);
+            }
+            else if (rest.next(ref) && ref[0] == '@') {
+                uint64_t id = 0;
+                auto it = parseNumber(ref.substr(1), id) ? programs.find(id) : programs.end();
+                if (it == programs.end()) {
+                    error = "undefined program " + std::string(ref);
+                }
+                else {
+                    pending.program = it->second;
+                }
+            }
+            else if (parseBlock(tokens, instructions, false, error)) {
+                pending.program = std::make_shared<const Program>(Program::compile(instructions, maxVariables));
+            }
+
+            if (error.empty()) {
+                lastTick = pending.tick;
+                return true;
+            }
+        }
+    }
+
+    std::cerr << path << ":" << lineNumber << ": " << error << "; line skipped\n";
+    return false;
+}
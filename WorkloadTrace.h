@@ -0,0 +1,82 @@
+#pragma once
+#include "Bytecode.h"
+#include "Process.h"
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Workload traces: the arrivals of a run (tick, name, program) as a text file
+// that can be replayed later or written by other tools. One record per line:
+//
+//   # comment
+//   program <id> <instructions>         shared program, defined once
+//   <tick> <name> @<id>                 arrival running a shared program
+//   <tick> <name> <instructions>        arrival with its own program
+//
+// Ticks count from when the trace was opened. Instructions are written
+// prefix-style with fixed arities, so they need no separators:
+//
+//   PRINT | DECLARE var value | ADD var a b | SUBTRACT var a b | SLEEP a | FOR n [ instructions ]
+//
+// where a and b are numbers or variable names. Variables must not contain
+// whitespace; in process names, whitespace and '%' are written as %XX.
+
+struct TraceArrival {
+    uint64_t tick = 0;
+    std::string name;
+    std::shared_ptr<const Program> program;
+};
+
+// Appends the arrivals of a run (config key "trace-record"). Programs that
+// other processes also hold (shared variants) are written once and referenced
+// by id; every other program is written inline with its arrival.
+class TraceWriter {
+public:
+    // Empty path disables recording. Truncates the file; returns false if it cannot be opened.
+    bool open(const std::string& path);
+    void close();
+    void flush();
+    bool isOpen() const { return file.is_open(); }
+
+    void record(uint64_t tick, const Process& proc);
+
+    // Appends program in trace syntax, decompiled from its bytecode
+    static void formatProgram(const Program& program, std::string& out);
+
+private:
+    std::mutex mutex;
+    std::ofstream file;
+    // Shared programs already written; holding them keeps their addresses from being reused
+    std::unordered_map<std::shared_ptr<const Program>, uint64_t> programIds;
+};
+
+// Streams arrivals from a trace file (config key "trace-replay") one line at a
+// time, so only shared program definitions stay in memory however long the
+// trace is. Malformed lines are reported and skipped.
+class TraceReader {
+public:
+    // Empty path disables replay. Returns false if the file cannot be opened.
+    bool open(const std::string& path, size_t maxVariables);
+    void close();
+    bool isOpen() const { return file.is_open(); }
+
+    // Next arrival in file order, nullptr once the trace is exhausted
+    const TraceArrival* peek();
+    void pop() { hasPending = false; }
+
+private:
+    std::ifstream file;
+    std::string path;
+    size_t maxVariables = 0;
+    uint64_t lineNumber = 0;
+    uint64_t lastTick = 0;
+    std::string line;
+    TraceArrival pending;
+    bool hasPending = false;
+    std::unordered_map<uint64_t, std::shared_ptr<const Program>> programs;
+
+    bool parseLine();
+};
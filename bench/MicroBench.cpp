@@ -0,0 +1,331 @@
+// Microbenchmarks for the interpreter hot path, process creation, the program
+// generator and the ready queues. Reports ns/op and heap allocations/op for each case.
+//
+//   csopesy-microbench [--filter TEXT] [--min-time MS]
+//
+// Interpreter cases count one op per executed instruction (clock tick). Queue
+// cases count one op per tryPop + requeue pair and report the average time a
+// single contending core thread spends on it.
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+#include "CpuClock.h"
+#include "Process.h"
+#include "ProgramGenerator.h"
+#include "SchedulingPolicy.h"
+
+// Heap allocations made by every thread, counted by the global operator new
+// overloads below so cases that allocate on helper threads are counted too
+static std::atomic<uint64_t> heapAllocations{ 0 };
+
+static uint64_t allocationsSoFar() { return heapAllocations.load(std::memory_order_relaxed); }
+
+void* operator new(std::size_t size) {
+    heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+// Over-aligned types (alignas above the default) go through these;
+// the block malloc returned is stored just before the aligned pointer
+void* operator new(std::size_t size, std::align_val_t align) {
+    heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    std::size_t alignment = static_cast<std::size_t>(align);
+    if (void* raw = std::malloc(size + alignment + sizeof(void*))) {
+        std::uintptr_t base = reinterpret_cast<std::uintptr_t>(raw) + sizeof(void*);
+        void* p = reinterpret_cast<void*>((base + alignment - 1) & ~(alignment - 1));
+        static_cast<void**>(p)[-1] = raw;
+        return p;
+    }
+    throw std::bad_alloc();
+}
+void operator delete(void* p, std::align_val_t) noexcept {
+    if (p) std::free(static_cast<void**>(p)[-1]);
+}
+void operator delete(void* p, std::size_t, std::align_val_t align) noexcept { operator delete(p, align); }
+
+namespace {
+
+using BenchClock = std::chrono::steady_clock;
+
+struct Options {
+    std::string filter;
+    std::chrono::milliseconds minTime{ 200 };
+};
+
+struct Result {
+    uint64_t ops = 0;
+    double nanos = 0;
+    uint64_t allocations = 0;
+};
+
+Options options;
+
+bool selected(const std::string& name) {
+    return options.filter.empty() || name.find(options.filter) != std::string::npos;
+}
+
+double elapsedNanos(BenchClock::time_point start) {
+    return std::chrono::duration<double, std::nano>(BenchClock::now() - start).count();
+}
+
+void report(const std::string& name, const Result& result) {
+    double ops = result.ops > 0 ? static_cast<double>(result.ops) : 1.0;
+    std::cout << std::left << std::setw(40) << name << std::right
+              << std::fixed << std::setprecision(1) << std::setw(12) << result.nanos / ops
+              << std::setprecision(3) << std::setw(14) << result.allocations / ops
+              << std::setw(12) << result.ops << "\n";
+}
+
+// ---- Interpreter ----
+
+std::vector<Instruction> repeated(const Instruction& instruction, int count) {
+    return std::vector<Instruction>(count, instruction);
+}
+
+// FOR nest of the given depth, 4 iterations per level, around one ADD
+Instruction nestedFor(int depth) {
+    Instruction body(InstructionType::ADD, { "x", "x", "1" });
+    for (int d = 0; d < depth; ++d) {
+        body = Instruction(InstructionType::FOR, {}, { body }, 4);
+    }
+    return body;
+}
+
+// Runs fresh copies of the program to completion until minTime has been spent
+// inside Process::run. SLEEP returns to the caller after every op, so that case
+// includes the cost of re-entering run().
+// With memory, variables are demand-paged and the process is pinned around
+// each run like a dispatched one, so only the first access to a page faults.
+Result runProgram(const std::vector<Instruction>& instructions, std::shared_ptr<MemoryManager> memory = nullptr) {
+    CpuClock clock;
+    std::atomic<bool> running{ true };
+    Result result;
+
+    while (result.nanos < std::chrono::duration<double, std::nano>(options.minTime).count()) {
+        Process proc(1, "bench", instructions, 32, 256);
+        if (memory) {
+            proc.attachMemory(memory);
+            proc.getPageTable()->pin();
+        }
+        uint64_t startTick = clock.now();
+        uint64_t startAllocations = allocationsSoFar();
+        auto start = BenchClock::now();
+
+        while (proc.run(0, 0, 0, running, clock) != RunResult::FINISHED) {
+        }
+
+        result.nanos += elapsedNanos(start);
+        result.allocations += allocationsSoFar() - startAllocations;
+        result.ops += clock.now() - startTick;
+        if (memory) proc.getPageTable()->unpin();
+    }
+    return result;
+}
+
+void benchInterpreter() {
+    const int lines = 4096;
+    struct Case {
+        std::string name;
+        std::vector<Instruction> instructions;
+    };
+    std::vector<Case> cases = {
+        { "exec PRINT", repeated(Instruction(InstructionType::PRINT), lines) },
+        { "exec DECLARE", repeated(Instruction(InstructionType::DECLARE, { "x", "10" }), lines) },
+        { "exec ADD", repeated(Instruction(InstructionType::ADD, { "x", "x", "1" }), lines) },
+        { "exec SUBTRACT", repeated(Instruction(InstructionType::SUBTRACT, { "x", "x", "1" }), lines) },
+        { "exec SLEEP", repeated(Instruction(InstructionType::SLEEP, { "1" }), lines) },
+    };
+    for (int depth = 1; depth <= 3; ++depth) {
+        cases.push_back({ "exec FOR depth " + std::to_string(depth), repeated(nestedFor(depth), 256) });
+    }
+
+    for (const auto& c : cases) {
+        if (selected(c.name)) report(c.name, runProgram(c.instructions));
+    }
+
+    // Same ADD loop with its variable in paged memory
+    std::string paged = "exec ADD (paged)";
+    if (selected(paged)) {
+        auto memory = std::make_shared<MemoryManager>(4096, 16, MemoryManager::Replacement::LRU, "");
+        report(paged, runProgram(repeated(Instruction(InstructionType::ADD, { "x", "x", "1" }), lines), memory));
+    }
+}
+
+// ---- Process creation ----
+
+void benchCreation() {
+    const int count = 1000;
+    ProgramGenerator::Rng rng(1);
+
+    if (selected("generateInstructions")) {
+        Result result;
+        while (result.nanos < std::chrono::duration<double, std::nano>(options.minTime).count()) {
+            uint64_t startAllocations = allocationsSoFar();
+            auto start = BenchClock::now();
+            auto instructions = ProgramGenerator::generateInstructions(rng, count);
+            result.nanos += elapsedNanos(start);
+            result.allocations += allocationsSoFar() - startAllocations;
+            ++result.ops;
+        }
+        report("generateInstructions(" + std::to_string(count) + ")", result);
+    }
+
+    if (selected("create Process")) {
+        auto instructions = ProgramGenerator::generateInstructions(rng, count);
+        Result result;
+        while (result.nanos < std::chrono::duration<double, std::nano>(options.minTime).count()) {
+            uint64_t startAllocations = allocationsSoFar();
+            auto start = BenchClock::now();
+            auto proc = Process::create(1, "bench", instructions, 32, 256);
+            result.nanos += elapsedNanos(start);
+            result.allocations += allocationsSoFar() - startAllocations;
+            ++result.ops;
+        }
+        report("create Process(" + std::to_string(count) + " instructions)", result);
+    }
+
+    if (selected("create Process (shared program)")) {
+        auto program = std::make_shared<const Program>(Program::compile(ProgramGenerator::generateInstructions(rng, count), 32));
+        Result result;
+        while (result.nanos < std::chrono::duration<double, std::nano>(options.minTime).count()) {
+            uint64_t startAllocations = allocationsSoFar();
+            auto start = BenchClock::now();
+            auto proc = Process::create(1, "bench", program, 256);
+            result.nanos += elapsedNanos(start);
+            result.allocations += allocationsSoFar() - startAllocations;
+            ++result.ops;
+        }
+        report("create Process (shared program)", result);
+    }
+}
+
+// Programs per second delivered by ProgramGenerator::next() with the given
+// number of generator threads (one op per program taken)
+Result drainGenerator(int threads) {
+    ProgramGenerator generator;
+    ProgramGenerator::Params params;
+    params.minInstructions = 1000;
+    params.maxInstructions = 1000;
+    params.maxVariables = 32;
+    generator.reset(params, nullptr);
+    generator.start(threads, 64);
+
+    Result result;
+    uint64_t startAllocations = allocationsSoFar();
+    auto start = BenchClock::now();
+    while (result.nanos < std::chrono::duration<double, std::nano>(options.minTime).count()) {
+        auto program = generator.next();
+        ++result.ops;
+        result.nanos = elapsedNanos(start);
+    }
+    result.allocations = allocationsSoFar() - startAllocations;
+    generator.stop();
+    return result;
+}
+
+void benchGenerator() {
+    for (int threads = 1; threads <= 4; threads *= 2) {
+        std::string name = "generator x" + std::to_string(threads);
+        if (selected(name)) report(name, drainGenerator(threads));
+    }
+}
+
+// ---- Ready queues ----
+
+Result contendQueue(const std::string& schedulerType, const std::string& readyQueueMode, int threads) {
+    auto policy = SchedulingPolicy::create(schedulerType, readyQueueMode, threads, 5);
+    std::vector<Instruction> tiny = { Instruction(InstructionType::PRINT) };
+    for (int i = 0; i < threads * 4; ++i) {
+        policy->admit(Process::create(i, "q" + std::to_string(i), tiny));
+    }
+
+    const int iterations = std::max(2000, 400000 / threads);
+    std::atomic<bool> go{ false };
+    std::atomic<uint64_t> totalOps{ 0 };
+
+    std::vector<std::thread> workers;
+    for (int id = 0; id < threads; ++id) {
+        workers.emplace_back([&, id] {
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            uint64_t ops = 0;
+            for (int i = 0; i < iterations; ++i) {
+                auto proc = policy->tryPop(id);
+                if (!proc) continue;
+                policy->requeue(std::move(proc), RunResult::PREEMPTED, id);
+                ++ops;
+            }
+            totalOps += ops;
+        });
+    }
+
+    uint64_t startAllocations = allocationsSoFar();
+    auto start = BenchClock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& t : workers) t.join();
+
+    Result result;
+    result.ops = totalOps;
+    result.allocations = allocationsSoFar() - startAllocations;
+    result.nanos = elapsedNanos(start) * threads; // per-thread latency
+    return result;
+}
+
+void benchQueues() {
+    struct Mode {
+        std::string schedulerType;
+        std::string readyQueueMode;
+    };
+    const Mode modes[] = { { "fcfs", "global" }, { "fcfs", "per-core" }, { "sjf", "global" } };
+
+    for (const auto& mode : modes) {
+        for (int threads = 1; threads <= 64; threads *= 2) {
+            std::string name = "queue " + mode.schedulerType + "/" + mode.readyQueueMode
+                + " x" + std::to_string(threads);
+            if (selected(name)) report(name, contendQueue(mode.schedulerType, mode.readyQueueMode, threads));
+        }
+    }
+}
+
+bool parseArgs(int argc, char* argv[]) {
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        if (arg == "--filter") {
+            options.filter = argv[i + 1];
+        }
+        else if (arg == "--min-time") {
+            options.minTime = std::chrono::milliseconds(std::atoi(argv[i + 1]));
+        }
+        else {
+            return false;
+        }
+    }
+    return argc % 2 == 1;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (!parseArgs(argc, argv)) {
+        std::cerr << "Usage: csopesy-microbench [--filter TEXT] [--min-time MS]\n";
+        return 1;
+    }
+
+    std::cout << std::left << std::setw(40) << "benchmark" << std::right
+              << std::setw(12) << "ns/op" << std::setw(14) << "allocs/op" << std::setw(12) << "ops" << "\n";
+    benchInterpreter();
+    benchCreation();
+    benchGenerator();
+    benchQueues();
+    return 0;
+}
@@ -4,6 +4,7 @@
 #include <sstream>
 #include <thread>
 #include <chrono>
+#include <cstdlib>
 #include <vector>
 #include "Scheduler.h"
 
@@ -28,16 +29,24 @@ void printHeader() {
     std::cout << "Type 'exit' to quit, 'clear' to clear the screen\n";
 }
 
-void clearScreen() {
+void clearConsole() {
+#ifdef _WIN32
     system("cls");
+#else
+    system("clear");
+#endif
+}
+
+void clearScreen() {
+    clearConsole();
     printHeader();
 }
 
 
 void initializeEmulator() {
-    // Initialize the processor configuration of the application with config.txt
+    // Initialize the processor configuration of the application with Config.txt
     std::cout << "Initialize command recognized. Configuring OS Emulator...\n";
-    scheduler.initialize("config.txt");
+    scheduler.initialize("Config.txt");
 }
 
 
@@ -53,6 +62,19 @@ void stopScheduler() {
     scheduler.stop();
 }
 
+// Prints the log entries appended since the last call with this cursor, so
+// repeated process-smi calls only fetch what is new.
+void printNewLogs(const Process& process, uint64_t& logCursor) {
+    std::vector<std::string> logs;
+    uint64_t dropped = process.readLogs(logCursor, logs);
+    if (dropped > 0) {
+        std::cout << "... " << dropped << " older log entries discarded ...\n";
+    }
+    for (const auto& log : logs) {
+        std::cout << log << "\n";
+    }
+}
+
 void attachToProcess(const std::string& command) {
     std::string processName = command.substr(10);
 
@@ -77,15 +99,14 @@ void attachToProcess(const std::string& command) {
     }
 
     // Clear screen & show process info
-    system("cls");
+    uint64_t logCursor = 0;
+    clearConsole();
     std::cout << "Attached to process: " << processName << "\n";
-    auto logs = process->getLogs();
     std::cout << "Process name: " << processName << "\n";
     std::cout << "ID: " << process->getId() << "\n";
+    std::cout << "Context switches: " << process->getContextSwitches() << "\n";
     std::cout << "Logs:\n";
-    for (const auto& log : logs) {
-        std::cout << log << "\n";
-    }
+    printNewLogs(*process, logCursor);
     if (process->getCurrentLine() == process->getTotalLines()) {
         std::cout << "Finished!\n";
     }
@@ -101,13 +122,11 @@ void attachToProcess(const std::string& command) {
         std::getline(std::cin, subCommand);
 
         if (subCommand == "process-smi") {
-            auto logs = process->getLogs();
             std::cout << "Process name: " << processName << "\n";
             std::cout << "ID: " << process->getId() << "\n";
+            std::cout << "Context switches: " << process->getContextSwitches() << "\n";
             std::cout << "Logs:\n";
-            for (const auto& log : logs) {
-                std::cout << log << "\n";
-            }
+            printNewLogs(*process, logCursor);
             if (process->getCurrentLine() == process->getTotalLines()) {
                 std::cout << "\nFinished!\n";
             }
@@ -133,20 +152,24 @@ void attachToProcess(const std::string& command) {
 
 void reattachToProcess(const std::string& command) {
     std::string processName = command.substr(10); // skip "screen -r "
-    auto it = scheduler.runningProcesses.find(processName);
-    if (it != scheduler.runningProcesses.end()) {
-        auto process = it->second;
-        system("cls");
+    auto process = scheduler.findProcessByName(processName);
+    // A number that is not a process name is taken as a PID
+    if (!process && !processName.empty() && processName.size() < 10
+        && processName.find_first_not_of("0123456789") == std::string::npos) {
+        process = scheduler.findProcessById(std::stoi(processName));
+        if (process) processName = process->getName();
+    }
+    if (process && process->getState() != ProcessState::FINISHED) {
+        uint64_t logCursor = 0;
+        clearConsole();
         std::cout << "Re-attached to process: " << processName << "\n";
 
         // Print the same details as "process-smi"
-        auto logs = process->getLogs();
         std::cout << "Process name: " << processName << "\n";
         std::cout << "ID: " << process->getId() << "\n";
+        std::cout << "Context switches: " << process->getContextSwitches() << "\n";
         std::cout << "Logs:\n";
-        for (const auto& log : logs) {
-            std::cout << log << "\n";
-        }
+        printNewLogs(*process, logCursor);
         if (process->getCurrentLine() == process->getTotalLines()) {
             std::cout <<"\nFinished!\n";
         }
@@ -224,6 +247,9 @@ void enterMainLoop() {
             else if (command == "screen -ls") { // "List all processes"
                 scheduler.printStatus();
             }
+            else if (command.rfind("screen -ls ", 0) == 0) { // Older finished processes, one page at a time
+                scheduler.printStatus(std::strtoul(command.c_str() + 11, nullptr, 10));
+            }
             else if (command == "scheduler-start") {
                 startScheduler();
             }
@@ -233,6 +259,15 @@ void enterMainLoop() {
             else if (command == "report-util") { // Saves "screen -ls" in csopesy-log.txt
                 scheduler.writeStatusToFile();
             }
+            else if (command == "process-stats") { // Tick statistics for every process
+                scheduler.printProcessStats("");
+            }
+            else if (command.rfind("process-stats ", 0) == 0) {
+                scheduler.printProcessStats(command.substr(14));
+            }
+            else if (command == "vmstat") { // Paged memory usage and page-in/page-out counts
+                scheduler.printMemoryStats();
+            }
             else if (command == "clear") { // Clears the screen
                 clearScreen();
             }